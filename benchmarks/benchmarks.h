@@ -0,0 +1,7 @@
+#ifndef BENCHMARKS_H
+#define BENCHMARKS_H
+
+void run_queue_benchmarks ();
+void run_pool_benchmarks ();
+
+#endif // BENCHMARKS_H
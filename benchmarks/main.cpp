@@ -0,0 +1,7 @@
+#include "benchmarks.h"
+
+int main () {
+	run_queue_benchmarks ();
+	run_pool_benchmarks ();
+	return 0;
+}
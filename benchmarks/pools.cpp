@@ -0,0 +1,103 @@
+#include "benchmarks.h"
+#include "core/storage/lifetime/pool.h"
+#include "core/storage/state.h"
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// Pool acquire/release round trips over a handful of warm buckets. The
+// cloning baseline probes the same map the way Pool did before borrowed
+// probes: by building an owning IStateKey for every lookup.
+
+namespace {
+constexpr int round_trips = 2'000'000;
+constexpr int bucket_count = 8;
+
+struct BenchState final : IState<BenchState> {
+	explicit BenchState (const int width = 0, const int height = 0)
+		: width (width), height (height) {}
+
+	[[nodiscard]] size_t hash () const override {
+		return static_cast<size_t> (width) * 73856093u
+			   ^ static_cast<size_t> (height) * 19349663u;
+	}
+	[[nodiscard]] bool equals (const BenchState& other) const override {
+		return width == other.width && height == other.height;
+	}
+	[[nodiscard]] std::unique_ptr<BenchState> clone () const override {
+		return std::make_unique<BenchState> (*this);
+	}
+
+	int width;
+	int height;
+};
+
+struct BenchFactory {
+	Handle create (const BenchState&) { return Handle{next_id++, 0}; }
+	void destroy (Handle) {}
+
+	uint32_t next_id = 0;
+};
+
+// The pre-probe lookup, kept here as the baseline.
+class CloningPool {
+  public:
+	Handle acquire (const BenchState& state) {
+		IStateKey<BenchState> key (state);
+		auto [it, inserted] = buckets.try_emplace (std::move (key));
+		std::vector<Handle>& free = it->second;
+		if (free.empty ())
+			return factory.create (state);
+
+		const Handle handle = free.back ();
+		free.pop_back ();
+		return handle;
+	}
+
+	void release (const BenchState& state, const Handle handle) {
+		IStateKey<BenchState> key (state);
+		buckets.try_emplace (std::move (key)).first->second.push_back (handle);
+	}
+
+  private:
+	BenchFactory factory;
+	std::unordered_map<
+		IStateKey<BenchState>, std::vector<Handle>,
+		IStateKey<BenchState>::Hash, IStateKey<BenchState>::Equals>
+		buckets;
+};
+
+template <class AnyPool> double run (AnyPool& pool) {
+	std::vector<BenchState> states;
+	for (int i = 0; i < bucket_count; ++i)
+		states.emplace_back (256 << (i % 4), 256 << (i / 4));
+
+	for (const BenchState& state : states)
+		pool.release (state, pool.acquire (state));
+
+	const auto start = std::chrono::steady_clock::now ();
+	for (int i = 0; i < round_trips; ++i) {
+		const BenchState& state = states[i % bucket_count];
+		pool.release (state, pool.acquire (state));
+	}
+	const std::chrono::duration<double> elapsed
+		= std::chrono::steady_clock::now () - start;
+
+	return round_trips / elapsed.count () / 1e6;
+}
+} // namespace
+
+void run_pool_benchmarks () {
+	CloningPool cloning;
+	const double before = run (cloning);
+
+	BenchFactory factory;
+	Pool<BenchState, BenchFactory> pool (factory);
+	const double after = run (pool);
+
+	std::printf ("pool     cloned keys     %8.2f Mround trips/s\n", before);
+	std::printf ("pool     borrowed probes %8.2f Mround trips/s\n", after);
+}
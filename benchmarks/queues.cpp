@@ -0,0 +1,119 @@
+#include "benchmarks.h"
+#include "core/queues/mpmc.h"
+#include "core/queues/spsc.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// Throughput of the lock-free queues against a mutex guarded std::queue.
+// Every producer pushes items_per_producer ints; the time until consumers
+// have popped all of them is reported as millions of items per second.
+
+namespace {
+constexpr int items_per_producer = 1'000'000;
+constexpr size_t capacity = 1024;
+
+class MutexQueue {
+  public:
+	bool try_push (const int item) {
+		std::lock_guard lock (mutex);
+		if (queue.size () >= capacity)
+			return false;
+		queue.push (item);
+		return true;
+	}
+
+	bool try_pop (int& out) {
+		std::lock_guard lock (mutex);
+		if (queue.empty ())
+			return false;
+		out = queue.front ();
+		queue.pop ();
+		return true;
+	}
+
+  private:
+	std::mutex mutex;
+	std::queue<int> queue;
+};
+
+template <class Queue>
+double run (Queue& queue, const int producers, const int consumers) {
+	const int total = producers * items_per_producer;
+	std::atomic<int> popped{0};
+	std::atomic<bool> go{false};
+
+	std::vector<std::thread> threads;
+	for (int p = 0; p < producers; ++p)
+		threads.emplace_back ([&] {
+			while (!go.load ())
+				std::this_thread::yield ();
+			for (int i = 0; i < items_per_producer; ++i)
+				while (!queue.try_push (i))
+					std::this_thread::yield ();
+		});
+	for (int c = 0; c < consumers; ++c)
+		threads.emplace_back ([&] {
+			while (!go.load ())
+				std::this_thread::yield ();
+			int value;
+			while (popped.load (std::memory_order_relaxed) < total) {
+				if (queue.try_pop (value))
+					popped.fetch_add (1, std::memory_order_relaxed);
+				else
+					std::this_thread::yield ();
+			}
+		});
+
+	const auto start = std::chrono::steady_clock::now ();
+	go.store (true);
+	for (std::thread& thread : threads)
+		thread.join ();
+	const std::chrono::duration<double> elapsed
+		= std::chrono::steady_clock::now () - start;
+
+	return total / elapsed.count () / 1e6;
+}
+
+void report (
+	const char* name, const int producers, const int consumers,
+	const double mops
+) {
+	std::printf (
+		"%-8s %dp/%dc  %8.2f Mitems/s\n", name, producers, consumers, mops
+	);
+}
+} // namespace
+
+void run_queue_benchmarks () {
+	{
+		SpscQueue<int> spsc (capacity);
+		report ("spsc", 1, 1, run (spsc, 1, 1));
+	}
+	{
+		MpmcQueue<int> mpmc (capacity);
+		report ("mpmc", 1, 1, run (mpmc, 1, 1));
+	}
+	{
+		MutexQueue mutex;
+		report ("mutex", 1, 1, run (mutex, 1, 1));
+	}
+
+	const int threads = static_cast<int> (
+		std::max (2u, std::thread::hardware_concurrency ()) / 2
+	);
+	{
+		MpmcQueue<int> mpmc (capacity);
+		report ("mpmc", threads, threads, run (mpmc, threads, threads));
+	}
+	{
+		MutexQueue mutex;
+		report ("mutex", threads, threads, run (mutex, threads, threads));
+	}
+}
@@ -22,14 +22,13 @@ AssetManager::load_mesh_from_file (const std::string& path) {
 	}
 
 	mesh->cpu_state.vertices = vertices;
-	meshes[path] = mesh;
-
 	return mesh;
 }
 
 std::shared_ptr<MeshInstance>
 AssetManager::load_mesh (const std::string& path) {
 	std::lock_guard lock (mesh_mutex);
+	apply_reloads ();
 
 	auto iterator = meshes.find (path);
 	if (iterator != meshes.end ())
@@ -43,18 +42,27 @@ AssetManager::load_mesh (const std::string& path) {
 void AssetManager::reload_mesh (const std::string& path) {
 	std::thread ([this, path] () {
 		auto new_mesh = load_mesh_from_file (path);
+		if (!new_mesh)
+			return;
 
-		{
-			std::lock_guard lock (mesh_mutex);
-			meshes[path] = new_mesh;
-		}
+		MeshReload reload{path, std::move (new_mesh)};
+		while (!reloads.try_push (std::move (reload)))
+			std::this_thread::yield ();
 
 		SDL_Log ("Hot-reloaded mesh: %s", path.c_str ());
 	}).detach ();
 }
 
+void AssetManager::apply_reloads () {
+	MeshReload reload;
+	while (reloads.try_pop (reload))
+		meshes[reload.path] = std::move (reload.mesh);
+}
+
 std::shared_ptr<MeshInstance> AssetManager::get_mesh (const std::string& path) {
 	std::lock_guard lock (mesh_mutex);
+	apply_reloads ();
+
 	auto iterator = meshes.find (path);
 	return iterator != meshes.end () ? iterator->second : nullptr;
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "core/queues/mpmc.h"
 #include "loader.h"
 
 #include <memory>
@@ -21,9 +22,18 @@ class AssetManager {
 	std::shared_ptr<MeshInstance> get_mesh (const std::string& path);
 
   private:
+	struct MeshReload {
+		std::string path;
+		std::shared_ptr<MeshInstance> mesh;
+	};
+
 	std::unordered_map<std::string, std::shared_ptr<MeshInstance>> meshes;
 	std::mutex mesh_mutex;
 
+	// Filled by reload threads, drained under mesh_mutex by the next lookup.
+	MpmcQueue<MeshReload> reloads{64};
+
 	std::shared_ptr<MeshInstance> load_mesh_from_file (const std::string& path);
+	void apply_reloads ();
 	std::shared_ptr<IMeshLoader> loader;
 };
@@ -0,0 +1,37 @@
+#include "allocations.h"
+
+#include <atomic>
+#include <cstdlib>
+
+namespace {
+std::atomic<uint64_t> heap_allocations{0};
+} // namespace
+
+void count_heap_allocation () {
+	heap_allocations.fetch_add (1, std::memory_order_relaxed);
+}
+
+uint64_t get_heap_allocations () {
+	return heap_allocations.load (std::memory_order_relaxed);
+}
+
+// Over-allocates and keeps malloc's pointer in the word just before the
+// aligned block.
+void* aligned_malloc (const size_t size, const size_t alignment) {
+	const size_t align = alignment < sizeof (void*) ? sizeof (void*)
+													: alignment;
+	void* raw = std::malloc (size + align + sizeof (void*));
+	if (!raw)
+		return nullptr;
+
+	const uintptr_t start = reinterpret_cast<uintptr_t> (raw)
+							+ sizeof (void*);
+	const uintptr_t aligned = (start + align - 1) & ~(align - 1);
+	reinterpret_cast<void**> (aligned)[-1] = raw;
+	return reinterpret_cast<void*> (aligned);
+}
+
+void aligned_free (void* memory) {
+	if (memory)
+		std::free (static_cast<void**> (memory)[-1]);
+}
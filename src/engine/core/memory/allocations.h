@@ -0,0 +1,20 @@
+#ifndef ALLOCATIONS_H
+#define ALLOCATIONS_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Process-wide heap allocation counter. The game executable replaces
+// operator new to call count_heap_allocation (); without that hook the
+// count stays at zero.
+void count_heap_allocation ();
+uint64_t get_heap_allocations ();
+
+// Portable malloc-backed aligned allocation for replacement operator new,
+// which cannot forward to the aligned operator it replaces and cannot rely
+// on std::aligned_alloc (missing on MSVC). Free with aligned_free only.
+// Returns nullptr on failure.
+void* aligned_malloc (size_t size, size_t alignment);
+void aligned_free (void* memory);
+
+#endif // ALLOCATIONS_H
@@ -0,0 +1,57 @@
+#include "frame_arena.h"
+
+#include <bit>
+#include <cassert>
+#include <new>
+
+namespace {
+std::byte* allocate_block (const size_t size) {
+	return static_cast<std::byte*> (::operator new (
+		size, std::align_val_t{FrameArena::max_alignment}
+	));
+}
+
+void release_block (std::byte* block) {
+	::operator delete (block, std::align_val_t{FrameArena::max_alignment});
+}
+} // namespace
+
+FrameArena::FrameArena (const size_t capacity)
+	: buffer (allocate_block (capacity)), capacity (capacity) {}
+
+FrameArena::~FrameArena () {
+	for (std::byte* block : overflow)
+		release_block (block);
+	release_block (buffer);
+}
+
+void* FrameArena::do_allocate (const size_t bytes, const size_t alignment) {
+	assert (alignment <= max_alignment);
+
+	const size_t aligned = (offset + alignment - 1) & ~(alignment - 1);
+	if (aligned + bytes <= capacity) {
+		offset = aligned + bytes;
+		return buffer + aligned;
+	}
+
+	overflow.push_back (allocate_block (bytes));
+	spilled += bytes + max_alignment;
+	spills++;
+	return overflow.back ();
+}
+
+void FrameArena::reset () {
+	if (!overflow.empty ()) {
+		const size_t peak = offset + spilled;
+		for (std::byte* block : overflow)
+			release_block (block);
+		overflow.clear ();
+
+		release_block (buffer);
+		capacity = std::bit_ceil (peak);
+		buffer = allocate_block (capacity);
+	}
+
+	offset = 0;
+	spilled = 0;
+}
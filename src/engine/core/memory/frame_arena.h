@@ -0,0 +1,47 @@
+#ifndef FRAME_ARENA_H
+#define FRAME_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+// Bump allocator for data that lives exactly one frame. Deallocation is a
+// no-op; reset () rewinds everything at once. Allocations that do not fit
+// spill into their own blocks, and the next reset () grows the main block
+// to the frame's peak so a steady state needs no heap at all. Not thread
+// safe: one thread fills an arena at a time.
+class FrameArena final : public std::pmr::memory_resource {
+  public:
+	explicit FrameArena (size_t capacity = 256 * 1024);
+	~FrameArena () override;
+
+	FrameArena (const FrameArena&) = delete;
+	FrameArena& operator= (const FrameArena&) = delete;
+
+	void reset ();
+
+	[[nodiscard]] size_t used () const { return offset + spilled; }
+	[[nodiscard]] size_t size () const { return capacity; }
+	[[nodiscard]] uint64_t get_spills () const { return spills; }
+
+	static constexpr size_t max_alignment = 64;
+
+  private:
+	void* do_allocate (size_t bytes, size_t alignment) override;
+	void do_deallocate (void*, size_t, size_t) override {}
+	[[nodiscard]] bool
+	do_is_equal (const memory_resource& other) const noexcept override {
+		return this == &other;
+	}
+
+	std::byte* buffer = nullptr;
+	size_t capacity = 0;
+	size_t offset = 0;
+
+	std::vector<std::byte*> overflow;
+	size_t spilled = 0;
+	uint64_t spills = 0;
+};
+
+#endif // FRAME_ARENA_H
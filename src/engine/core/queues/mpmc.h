@@ -0,0 +1,117 @@
+#ifndef MPMC_H
+#define MPMC_H
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+// Bounded multi-producer multi-consumer ring (Vyukov). Every cell carries a
+// sequence number that tells producers and consumers whose turn it is, so
+// a push or pop is one CAS on the shared index plus one store to the cell.
+// Each cell and both indices sit on their own cache line.
+template <class T> class MpmcQueue {
+	static_assert (std::is_default_constructible_v<T>);
+	static_assert (std::is_nothrow_move_assignable_v<T>);
+
+  public:
+	explicit MpmcQueue (const size_t capacity)
+		: cells (std::make_unique<Cell[]> (capacity)), mask (capacity - 1) {
+		assert (capacity >= 2);
+		assert ((capacity & (capacity - 1)) == 0);
+		for (size_t i = 0; i < capacity; ++i)
+			cells[i].sequence.store (i, std::memory_order_relaxed);
+	}
+
+	MpmcQueue (const MpmcQueue&) = delete;
+	MpmcQueue& operator= (const MpmcQueue&) = delete;
+
+	// False when the queue is full; item is left untouched.
+	bool try_push (T&& item) {
+		Cell* cell;
+		size_t position = tail.load (std::memory_order_relaxed);
+		for (;;) {
+			cell = &cells[position & mask];
+			const size_t sequence = cell->sequence.load (
+				std::memory_order_acquire
+			);
+			const auto difference = static_cast<std::ptrdiff_t> (
+				sequence - position
+			);
+
+			if (difference == 0) {
+				if (tail.compare_exchange_weak (
+						position, position + 1, std::memory_order_relaxed
+					))
+					break;
+			} else if (difference < 0) {
+				return false;
+			} else {
+				position = tail.load (std::memory_order_relaxed);
+			}
+		}
+
+		cell->value = std::move (item);
+		cell->sequence.store (position + 1, std::memory_order_release);
+		return true;
+	}
+
+	bool try_push (const T& item) {
+		T copy = item;
+		return try_push (std::move (copy));
+	}
+
+	bool try_pop (T& out) {
+		Cell* cell;
+		size_t position = head.load (std::memory_order_relaxed);
+		for (;;) {
+			cell = &cells[position & mask];
+			const size_t sequence = cell->sequence.load (
+				std::memory_order_acquire
+			);
+			const auto difference = static_cast<std::ptrdiff_t> (
+				sequence - (position + 1)
+			);
+
+			if (difference == 0) {
+				if (head.compare_exchange_weak (
+						position, position + 1, std::memory_order_relaxed
+					))
+					break;
+			} else if (difference < 0) {
+				return false;
+			} else {
+				position = head.load (std::memory_order_relaxed);
+			}
+		}
+
+		out = std::move (cell->value);
+		cell->sequence.store (position + mask + 1, std::memory_order_release);
+		return true;
+	}
+
+	[[nodiscard]] size_t size_approx () const {
+		const size_t t = tail.load (std::memory_order_relaxed);
+		const size_t h = head.load (std::memory_order_relaxed);
+		return t > h ? t - h : 0;
+	}
+
+	[[nodiscard]] bool empty () const { return size_approx () == 0; }
+	[[nodiscard]] size_t capacity () const { return mask + 1; }
+
+  private:
+	struct alignas (64) Cell {
+		std::atomic<size_t> sequence{0};
+		T value{};
+	};
+
+	std::unique_ptr<Cell[]> cells;
+	size_t mask;
+
+	alignas (64) std::atomic<size_t> tail{0};
+	alignas (64) std::atomic<size_t> head{0};
+};
+
+#endif // MPMC_H
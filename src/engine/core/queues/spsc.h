@@ -0,0 +1,81 @@
+#ifndef SPSC_H
+#define SPSC_H
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+// Bounded single-producer single-consumer ring. Each side keeps a cached
+// copy of the other side's index and only reloads it when the ring looks
+// full or empty, so the shared lines are touched once per wrap at best.
+template <class T> class SpscQueue {
+	static_assert (std::is_default_constructible_v<T>);
+	static_assert (std::is_nothrow_move_assignable_v<T>);
+
+  public:
+	explicit SpscQueue (const size_t capacity)
+		: slots (std::make_unique<T[]> (capacity)), mask (capacity - 1) {
+		assert (capacity >= 2);
+		assert ((capacity & (capacity - 1)) == 0);
+	}
+
+	SpscQueue (const SpscQueue&) = delete;
+	SpscQueue& operator= (const SpscQueue&) = delete;
+
+	// Producer thread only. False when the queue is full.
+	bool try_push (T&& item) {
+		const size_t t = tail.load (std::memory_order_relaxed);
+		if (t - cached_head > mask) {
+			cached_head = head.load (std::memory_order_acquire);
+			if (t - cached_head > mask)
+				return false;
+		}
+
+		slots[t & mask] = std::move (item);
+		tail.store (t + 1, std::memory_order_release);
+		return true;
+	}
+
+	bool try_push (const T& item) {
+		T copy = item;
+		return try_push (std::move (copy));
+	}
+
+	// Consumer thread only.
+	bool try_pop (T& out) {
+		const size_t h = head.load (std::memory_order_relaxed);
+		if (h == cached_tail) {
+			cached_tail = tail.load (std::memory_order_acquire);
+			if (h == cached_tail)
+				return false;
+		}
+
+		out = std::move (slots[h & mask]);
+		head.store (h + 1, std::memory_order_release);
+		return true;
+	}
+
+	[[nodiscard]] size_t size_approx () const {
+		const size_t t = tail.load (std::memory_order_relaxed);
+		const size_t h = head.load (std::memory_order_relaxed);
+		return t > h ? t - h : 0;
+	}
+
+	[[nodiscard]] bool empty () const { return size_approx () == 0; }
+	[[nodiscard]] size_t capacity () const { return mask + 1; }
+
+  private:
+	std::unique_ptr<T[]> slots;
+	size_t mask;
+
+	alignas (64) std::atomic<size_t> tail{0};
+	size_t cached_head = 0;
+
+	alignas (64) std::atomic<size_t> head{0};
+	size_t cached_tail = 0;
+};
+
+#endif // SPSC_H
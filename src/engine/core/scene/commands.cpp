@@ -0,0 +1,175 @@
+#include "commands.h"
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+#include "scene.h"
+
+namespace {
+std::atomic<uint64_t> next_commands_id{1};
+
+struct CachedBuffer {
+	uint64_t owner = 0;
+	void* buffer = nullptr;
+};
+
+// Threads usually record into one scene at a time, so a few entries are
+// enough; the oldest is overwritten when full. Ids are never reused, so
+// entries of dead scenes never match.
+constexpr size_t cached_buffers = 4;
+thread_local std::array<CachedBuffer, cached_buffers> buffer_cache{};
+thread_local size_t buffer_cache_next = 0;
+} // namespace
+
+SceneCommands::SceneCommands () : id (next_commands_id.fetch_add (1)) {}
+
+void SceneCommands::spawn (
+	std::unique_ptr<IEntity> entity, std::string parent
+) {
+	SceneCommand command;
+	command.type = SceneCommandType::Spawn;
+	command.entity = entity->name;
+	command.spawned = std::move (entity);
+
+	if (!parent.empty ()) {
+		SceneCommand attach;
+		attach.type = SceneCommandType::Reparent;
+		attach.entity = command.entity;
+		attach.parent = std::move (parent);
+		record (std::move (command));
+		record (std::move (attach));
+		return;
+	}
+	record (std::move (command));
+}
+
+void SceneCommands::destroy (std::string entity) {
+	SceneCommand command;
+	command.type = SceneCommandType::Destroy;
+	command.entity = std::move (entity);
+	record (std::move (command));
+}
+
+void SceneCommands::reparent (std::string entity, std::string parent) {
+	SceneCommand command;
+	command.type = SceneCommandType::Reparent;
+	command.entity = std::move (entity);
+	command.parent = std::move (parent);
+	record (std::move (command));
+}
+
+SceneCommands::Buffer& SceneCommands::local () {
+	for (const CachedBuffer& cached : buffer_cache)
+		if (cached.owner == id)
+			return *static_cast<Buffer*> (cached.buffer);
+
+	// A miss may only mean the entry was evicted, so the thread's existing
+	// buffer is looked up before creating one; each thread owns at most one.
+	const std::thread::id thread = std::this_thread::get_id ();
+	Buffer* buffer = nullptr;
+	{
+		std::lock_guard lock (buffers_mutex);
+		for (const auto& existing : buffers)
+			if (existing->thread == thread)
+				buffer = existing.get ();
+
+		if (!buffer) {
+			buffers.push_back (std::make_unique<Buffer> ());
+			buffer = buffers.back ().get ();
+			buffer->thread = thread;
+		}
+	}
+
+	CachedBuffer& slot = buffer_cache[buffer_cache_next++ % cached_buffers];
+	slot.owner = id;
+	slot.buffer = buffer;
+	return *buffer;
+}
+
+SceneCommandStats SceneCommands::apply (Scene& scene) {
+	batch.clear ();
+	for (const auto& buffer : buffers) {
+		std::move (
+			buffer->commands.begin (), buffer->commands.end (),
+			std::back_inserter (batch)
+		);
+		buffer->commands.clear ();
+	}
+
+	// Stable, so commands one thread recorded for the same entity keep
+	// their order.
+	std::stable_sort (
+		batch.begin (), batch.end (),
+		[] (const SceneCommand& a, const SceneCommand& b) {
+			if (a.type != b.type)
+				return a.type < b.type;
+			return a.entity < b.entity;
+		}
+	);
+
+	const auto find = [&scene] (const std::string& name) -> IEntity* {
+		const auto iterator = scene.scene_entities.find (name);
+		return iterator == scene.scene_entities.end ()
+				   ? nullptr
+				   : iterator->second.get ();
+	};
+
+	SceneCommandStats stats;
+	for (SceneCommand& command : batch) {
+		switch (command.type) {
+		case SceneCommandType::Spawn:
+			if (find (command.entity)) {
+				stats.rejected++;
+				break;
+			}
+			scene.add_entity (std::move (command.spawned));
+			stats.spawned++;
+			break;
+		case SceneCommandType::AddComponent:
+			if (IEntity* entity = find (command.entity)) {
+				command.attach (*entity);
+				stats.components_added++;
+			} else {
+				stats.rejected++;
+			}
+			break;
+		case SceneCommandType::RemoveComponent: {
+			IEntity* entity = find (command.entity);
+			if (entity && entity->remove_component (command.component))
+				stats.components_removed++;
+			else
+				stats.rejected++;
+			break;
+		}
+		case SceneCommandType::Reparent: {
+			IEntity* entity = find (command.entity);
+			IEntity* parent = command.parent.empty ()
+								  ? nullptr
+								  : find (command.parent);
+			bool valid = entity && (command.parent.empty () || parent);
+			for (const IEntity* up = parent; valid && up; up = up->parent)
+				valid = up != entity;
+
+			if (!valid) {
+				stats.rejected++;
+				break;
+			}
+			entity->set_parent (parent);
+			stats.reparented++;
+			break;
+		}
+		case SceneCommandType::Destroy:
+			if (scene.remove_entity (command.entity))
+				stats.destroyed++;
+			else
+				stats.rejected++;
+			break;
+		}
+	}
+
+	// Spawned entities not taken by the scene are released here, on the
+	// applying thread.
+	batch.clear ();
+	return stats;
+}
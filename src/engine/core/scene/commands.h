@@ -0,0 +1,113 @@
+#ifndef COMMANDS_H
+#define COMMANDS_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <typeindex>
+#include <vector>
+
+#include "entity/entity.h"
+
+class Scene;
+
+// Declared in the order commands are applied, so a batch can spawn an
+// entity, attach components, parent it and destroy something else at once.
+enum class SceneCommandType : uint8_t {
+	Spawn,
+	AddComponent,
+	RemoveComponent,
+	Reparent,
+	Destroy,
+};
+
+struct SceneCommand {
+	SceneCommandType type = SceneCommandType::Spawn;
+	std::string entity;
+	std::string parent;
+
+	std::unique_ptr<IEntity> spawned;
+	std::function<void (IEntity&)> attach;
+	std::type_index component = typeid (void);
+};
+
+struct SceneCommandStats {
+	uint64_t spawned = 0;
+	uint64_t destroyed = 0;
+	uint64_t components_added = 0;
+	uint64_t components_removed = 0;
+	uint64_t reparented = 0;
+	uint64_t rejected = 0;
+};
+
+// Structural scene changes recorded from any thread. Each thread appends to
+// its own buffer without locking; apply () merges every buffer, sorts the
+// batch by command type then entity name and applies it in one pass. It
+// must run while no thread is recording, e.g. after the simulation joined.
+class SceneCommands {
+  public:
+	SceneCommands ();
+
+	SceneCommands (const SceneCommands&) = delete;
+	SceneCommands& operator= (const SceneCommands&) = delete;
+
+	// An empty parent spawns a root entity.
+	void spawn (std::unique_ptr<IEntity> entity, std::string parent = {});
+	void destroy (std::string entity);
+	void reparent (std::string entity, std::string parent);
+
+	template <typename T, typename... Args>
+	void add_component (std::string entity, Args... args);
+	template <typename T> void remove_component (std::string entity);
+
+	SceneCommandStats apply (Scene& scene);
+
+	// One per thread that has recorded into this instance.
+	[[nodiscard]] size_t buffer_count () {
+		std::lock_guard lock (buffers_mutex);
+		return buffers.size ();
+	}
+
+  private:
+	struct Buffer {
+		std::thread::id thread;
+		std::vector<SceneCommand> commands;
+	};
+
+	Buffer& local ();
+	void record (SceneCommand command) {
+		local ().commands.push_back (std::move (command));
+	}
+
+	const uint64_t id;
+	std::vector<std::unique_ptr<Buffer>> buffers;
+	std::mutex buffers_mutex;
+
+	std::vector<SceneCommand> batch;
+};
+
+template <typename T, typename... Args>
+void SceneCommands::add_component (std::string entity, Args... args) {
+	SceneCommand command;
+	command.type = SceneCommandType::AddComponent;
+	command.entity = std::move (entity);
+	command.attach = [... args = std::move (args)] (IEntity& target) {
+		target.add_component<T> (args...);
+	};
+	record (std::move (command));
+}
+
+template <typename T>
+void SceneCommands::remove_component (std::string entity) {
+	SceneCommand command;
+	command.type = SceneCommandType::RemoveComponent;
+	command.entity = std::move (entity);
+	command.component = typeid (T);
+	record (std::move (command));
+}
+
+#endif // COMMANDS_H
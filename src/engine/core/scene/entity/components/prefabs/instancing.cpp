@@ -1,20 +1,41 @@
 #include "instancing.h"
+#include "runtime/tasks/tasks.h"
 #include "utils.h"
 
 void InstancingComponent::pack (
-	const glm::mat4& base_world, std::vector<Block>& out
+	const glm::mat4& base_world, std::pmr::vector<Block>& out,
+	TaskScheduler* task_scheduler, const float alpha
 ) const {
-	out.reserve (out.size () + instances.size ());
+	const size_t offset = out.size ();
+	out.resize (offset + instances.size ());
 
-	for (const auto& inst : instances) {
-		const glm::mat4 local = inst.to_mat4 ();
-		const glm::mat4 world = base_world * local;
+	const bool interpolate = alpha < 1.0f
+							 && previous_instances.size () == instances.size ();
 
-		Block block{};
-		write_vec4 (block, 0, world[0]);
-		write_vec4 (block, 1, world[1]);
-		write_vec4 (block, 2, world[2]);
-		write_vec4 (block, 3, world[3]);
-		out.push_back (block);
+	auto pack_range = [&] (const size_t begin, const size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			const glm::mat4 local
+				= interpolate ? Transform::interpolate (
+									previous_instances[i], instances[i], alpha
+								)
+									.to_mat4 ()
+							  : instances[i].to_mat4 ();
+			const glm::mat4 world = base_world * local;
+
+			Block& block = out[offset + i];
+			write_vec4 (block, 0, world[0]);
+			write_vec4 (block, 1, world[1]);
+			write_vec4 (block, 2, world[2]);
+			write_vec4 (block, 3, world[3]);
+		}
+	};
+
+	if (!task_scheduler) {
+		pack_range (0, instances.size ());
+		return;
 	}
+
+	task_scheduler->parallel_for (
+		0, instances.size (), parallel_grain, pack_range
+	);
 }
@@ -5,12 +5,23 @@
 #include "entity/entity.h"
 #include "render/memory.h"
 
+#include <memory_resource>
 #include <vector>
 
+class TaskScheduler;
+
 class InstancingComponent final : public IEntityComponent {
   public:
 	std::vector<Transform> instances;
-	void pack (const glm::mat4& base_world, std::vector<Block>& out) const;
+	std::vector<Transform> previous_instances;
+
+	void store_previous () { previous_instances = instances; }
+	void pack (
+		const glm::mat4& base_world, std::pmr::vector<Block>& out,
+		TaskScheduler* task_scheduler = nullptr, float alpha = 1.0f
+	) const;
+
+	static constexpr size_t parallel_grain = 1024;
 };
 
 #endif // INSTANCING_H
@@ -1,15 +1,30 @@
 #include "wave.h"
 
 #include "instancing.h"
+#include "runtime/tasks/tasks.h"
 
 void WaveComponent::apply (
-	InstancingComponent& instancing_component, const float time
+	InstancingComponent& instancing_component, const float time,
+	TaskScheduler* task_scheduler
 ) const {
-	for (auto& transform : instancing_component.instances) {
-		auto& pos = transform.position;
-		const float dist = glm::length (
-			glm::vec2 (pos.x - origin.x, pos.z - origin.z)
-		);
-		pos.y = sin (dist * 0.3f - time + phase_offset) * 2.0f;
+	auto& instances = instancing_component.instances;
+
+	auto apply_range = [&] (const size_t begin, const size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			auto& pos = instances[i].position;
+			const float dist = glm::length (
+				glm::vec2 (pos.x - origin.x, pos.z - origin.z)
+			);
+			pos.y = sin (dist * 0.3f - time + phase_offset) * 2.0f;
+		}
+	};
+
+	if (!task_scheduler) {
+		apply_range (0, instances.size ());
+		return;
 	}
+
+	task_scheduler->parallel_for (
+		0, instances.size (), parallel_grain, apply_range
+	);
 }
\ No newline at end of file
@@ -6,13 +6,19 @@
 #include <glm/glm.hpp>
 
 class InstancingComponent;
+class TaskScheduler;
 
 class WaveComponent final : public IEntityComponent {
   public:
 	WaveComponent (const glm::vec3 origin, const float phase_offset)
 		: origin (origin), phase_offset (phase_offset) {}
 
-	void apply (InstancingComponent& instancing_component, float time) const;
+	void apply (
+		InstancingComponent& instancing_component, float time,
+		TaskScheduler* task_scheduler = nullptr
+	) const;
+
+	static constexpr size_t parallel_grain = 2048;
 
   private:
 	glm::vec3 origin;
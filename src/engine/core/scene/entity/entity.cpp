@@ -2,16 +2,34 @@
 
 #include "utils.h"
 
+#include <algorithm>
+
 IEntity::IEntity (
 	std::string name, MeshInstance* mesh, MaterialInstance* material,
 	const Transform& transform, const Transform& world_transform
 )
 	: name (std::move (name)), transform (transform),
-	  world_transform (world_transform), mesh (mesh), material (material) {}
+	  previous_transform (transform), world_transform (world_transform),
+	  mesh (mesh), material (material) {}
 
 IEntity::~IEntity () = default;
 
+bool IEntity::remove_component (const std::type_index type) {
+	const auto iterator = components.find (type);
+	if (iterator == components.end ())
+		return false;
+
+	iterator->second->on_detach ();
+	components.erase (iterator);
+	return true;
+}
+
 void IEntity::set_parent (IEntity* in_entity) {
+	if (parent == in_entity)
+		return;
+
+	if (parent)
+		std::erase (parent->children, this);
 	parent = in_entity;
 	if (in_entity) {
 		in_entity->children.push_back (this);
@@ -38,3 +56,17 @@ void IEntity::update_world_transform () {
 		child->update_world_transform ();
 	}
 }
+
+glm::mat4 IEntity::interpolated_world_matrix (const float alpha) const {
+	if (alpha >= 1.0f)
+		return world_matrix;
+
+	const glm::mat4 local = Transform::interpolate (
+								previous_transform, transform, alpha
+	)
+								.to_mat4 ();
+
+	if (parent)
+		return parent->interpolated_world_matrix (alpha) * local;
+	return local;
+}
@@ -3,6 +3,7 @@
 
 #include "components/component.h"
 
+#include <cmath>
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 #include <set>
@@ -11,6 +12,8 @@
 struct MaterialInstance;
 struct MeshInstance;
 struct RenderState;
+class TaskScheduler;
+class TaskGroup;
 
 struct Transform {
 	glm::vec3 position{0.0f};
@@ -29,6 +32,23 @@ struct Transform {
 		m = m * glm::scale (glm::mat4 (1.0f), scale);
 		return m;
 	}
+
+	// Rotations take the shortest way around so 359 -> 1 does not spin.
+	[[nodiscard]] static Transform
+	interpolate (const Transform& from, const Transform& to, float alpha) {
+		const glm::vec3 turn = to.rotation - from.rotation;
+
+		Transform out;
+		out.position = glm::mix (from.position, to.position, alpha);
+		out.rotation = from.rotation
+					   + glm::vec3 (
+						   std::remainder (turn.x, 360.0f),
+						   std::remainder (turn.y, 360.0f),
+						   std::remainder (turn.z, 360.0f)
+					   ) * alpha;
+		out.scale = glm::mix (from.scale, to.scale, alpha);
+		return out;
+	}
 };
 
 #include <memory>
@@ -46,6 +66,7 @@ class IEntity {
 	std::string name;
 
 	Transform transform;
+	Transform previous_transform;
 	Transform world_transform;
 	glm::mat4 world_matrix{1.0f};
 
@@ -55,6 +76,10 @@ class IEntity {
 	IEntity* parent = nullptr;
 	std::vector<IEntity*> children;
 
+	TaskScheduler* task_scheduler = nullptr;
+	// The owning scene's group; jobs in it are cancelled on unload.
+	TaskGroup* task_group = nullptr;
+
 	virtual void on_load () {}
 	virtual void on_unload () {}
 	virtual void update (float dt_ms, float sim_time_ms) = 0;
@@ -63,6 +88,9 @@ class IEntity {
 	void add_child (IEntity* in_entity);
 	void update_world_transform ();
 
+	void store_previous_transform () { previous_transform = transform; }
+	[[nodiscard]] glm::mat4 interpolated_world_matrix (float alpha) const;
+
 	template <typename T, typename... Args> T& add_component (Args&&... args) {
 		static_assert (std::is_base_of_v<IEntityComponent, T>);
 		auto component = std::make_unique<T> (std::forward<Args> (args)...);
@@ -83,6 +111,11 @@ class IEntity {
 		return components.contains (typeid (T));
 	}
 
+	template <typename T> bool remove_component () {
+		return remove_component (typeid (T));
+	}
+	bool remove_component (std::type_index type);
+
   private:
 	std::unordered_map<std::type_index, std::unique_ptr<IEntityComponent>>
 		components;
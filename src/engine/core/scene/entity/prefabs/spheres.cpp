@@ -62,13 +62,5 @@ void Spheres::on_load () {
 
 void Spheres::on_unload () {}
 
-void Spheres::update (float dt_ms, float sim_time_ms) {
-	auto* inst = get_component<InstancingComponent> ();
-	auto* wave = get_component<WaveComponent> ();
-
-	if (!inst || !wave)
-		return;
-
-	float time = sim_time_ms * 0.001f;
-	wave->apply (*inst, time);
-}
+// The scene's wave system animates the grid.
+void Spheres::update (float dt_ms, float sim_time_ms) {}
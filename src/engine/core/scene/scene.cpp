@@ -1,13 +1,72 @@
 #include "scene.h"
 
 #include "entity/components/prefabs/instancing.h"
+#include "entity/components/prefabs/wave.h"
 #include "entity/entity.h"
 #include "render/drawable.h"
 #include "render/render.h"
 
+#include <cassert>
 #include <ranges>
+#include <string_view>
 
 #include "core/camera/camera.h"
+#include "runtime/tasks/tasks.h"
+
+namespace {
+// Built-in per-step work, registered ahead of any game systems. The two
+// history systems touch disjoint data and share the first wave; entity
+// updates may touch anything, so they run alone before the wave system.
+void add_builtin_systems (SceneSystems& systems) {
+	systems.add (
+		"transform_history", SystemAccess{}.write<Transform> (),
+		[] (Scene& scene, float, float) {
+			for (const auto& entity : scene.scene_entities | std::views::values)
+				entity->store_previous_transform ();
+		}
+	);
+	systems.add (
+		"instance_history", SystemAccess{}.write<InstancingComponent> (),
+		[] (Scene& scene, float, float) {
+			for (const auto& entity : scene.scene_entities | std::views::values)
+				if (auto* inst = entity->get_component<InstancingComponent> ())
+					inst->store_previous ();
+		}
+	);
+	systems.add (
+		"entity_update", SystemAccess{.exclusive = true},
+		[] (Scene& scene, const float dt_ms, const float sim_time_ms) {
+			for (const auto& entity : scene.scene_entities | std::views::values)
+				entity->update (dt_ms, sim_time_ms);
+		}
+	);
+	systems.add (
+		"wave",
+		SystemAccess{}.read<WaveComponent> ().write<InstancingComponent> (),
+		[] (Scene& scene, float, const float sim_time_ms) {
+			const float time = sim_time_ms * 0.001f;
+			for (const auto& [name, entity] : scene.scene_entities) {
+				auto* inst = entity->get_component<InstancingComponent> ();
+				auto* wave = entity->get_component<WaveComponent> ();
+				if (inst && wave)
+					wave->apply (*inst, time, scene.task_scheduler);
+			}
+		}
+	);
+}
+
+void collect_subtree (IEntity& entity, std::pmr::vector<EntityView>& out) {
+	const size_t index = out.size ();
+	EntityView& view = out.emplace_back ();
+	view.entity = &entity;
+	view.name = std::string_view (entity.name);
+	view.transform = entity.transform;
+
+	for (IEntity* child : entity.children)
+		collect_subtree (*child, out);
+	out[index].subtree_size = static_cast<uint32_t> (out.size () - index);
+}
+} // namespace
 
 Scene::Scene () {
 	Camera camera{};
@@ -23,16 +82,25 @@ Scene::Scene () {
 	camera.look_sensitivity = 0.1f;
 
 	camera_manager = std::make_unique<CameraManager> (camera);
+
+	add_builtin_systems (systems);
 }
 
 void Scene::on_load () {
+	task_group.reset ();
 	for (const auto& entity : scene_entities | std::views::values) {
+		entity->task_scheduler = task_scheduler;
+		entity->task_group = &task_group;
 		entity->on_load ();
 	}
 	loaded = true;
 }
 
 void Scene::on_unload () {
+	task_group.cancel ();
+	if (task_scheduler && !task_group.done ())
+		task_scheduler->wait (task_group);
+
 	for (const auto& entity : scene_entities | std::views::values) {
 		entity->on_unload ();
 	}
@@ -40,9 +108,7 @@ void Scene::on_unload () {
 }
 
 void Scene::update (const float dt_ms, const float sim_time_ms) {
-	for (const auto& e : scene_entities | std::views::values) {
-		e->update (dt_ms, sim_time_ms);
-	}
+	systems.run (*this, dt_ms, sim_time_ms, task_scheduler);
 
 	for (const auto& entity : scene_entities | std::views::values) {
 		if (!entity->parent) {
@@ -51,23 +117,45 @@ void Scene::update (const float dt_ms, const float sim_time_ms) {
 	}
 }
 
-void Scene::collect_drawables (RenderState& out_render_state) {
+void Scene::collect_drawables (
+	RenderState& out_render_state, const float alpha
+) {
+	// Drawables are allocated from the state's frame arena; resizing builds
+	// each one with that arena for its instance blocks too.
+	std::pmr::vector<Drawable>& drawables = out_render_state.drawables;
+	drawables.resize (scene_entities.size ());
+
+	size_t index = 0;
 	for (const auto& entity : scene_entities | std::views::values) {
-		Drawable drawable;
+		Drawable& drawable = drawables[index++];
 		drawable.mesh = entity->mesh;
 		drawable.material = entity->material;
-		drawable.model = entity->world_matrix;
+		drawable.model = entity->interpolated_world_matrix (alpha);
+
+		drawable.instance_buffer = nullptr;
+		drawable.index_buffer = nullptr;
+		drawable.vertex_buffer = nullptr;
 
 		drawable.instance_blocks.clear ();
 		if (entity->has_component<InstancingComponent> ()) {
 			const auto* inst = entity->get_component<InstancingComponent> ();
-			inst->pack (entity->world_matrix, drawable.instance_blocks);
+			inst->pack (
+				drawable.model, drawable.instance_blocks, task_scheduler, alpha
+			);
 		}
-
-		out_render_state.drawables.push_back (std::move (drawable));
 	}
 }
 
+void Scene::collect_entities (RenderState& out_render_state) const {
+	std::pmr::vector<EntityView>& entities = out_render_state.entities;
+	entities.clear ();
+	entities.reserve (scene_entities.size ());
+
+	for (const auto& entity : scene_entities | std::views::values)
+		if (!entity->parent)
+			collect_subtree (*entity, entities);
+}
+
 void Scene::add_entity (std::unique_ptr<IEntity> entity) {
 	assert (entity);
 	assert (!entity->name.empty ());
@@ -78,9 +166,38 @@ void Scene::add_entity (std::unique_ptr<IEntity> entity) {
 		return;
 	}
 
+	entity->task_scheduler = task_scheduler;
+	entity->task_group = &task_group;
 	if (loaded) {
 		entity->on_load ();
 	}
 
 	scene_entities.emplace (name, std::move (entity));
 }
+
+bool Scene::remove_entity (const std::string& name) {
+	const auto iterator = scene_entities.find (name);
+	if (iterator == scene_entities.end ())
+		return false;
+
+	IEntity& entity = *iterator->second;
+	if (loaded)
+		entity.on_unload ();
+
+	entity.set_parent (nullptr);
+	for (IEntity* child : entity.children)
+		child->parent = nullptr;
+
+	scene_entities.erase (iterator);
+	return true;
+}
+
+// Jobs in the scene's group may still hold entity pointers, so they finish
+// before a Destroy command can free what they use.
+SceneCommandStats Scene::apply_commands () {
+	if (task_scheduler && !task_group.done ())
+		task_scheduler->wait (task_group, WaitMode::Help);
+	assert (task_group.done ());
+
+	return commands.apply (*this);
+}
@@ -6,9 +6,13 @@
 #include <glm/glm.hpp>
 #include <string>
 
+#include "commands.h"
+#include "systems.h"
 #include "core/camera/camera.h"
+#include "runtime/tasks/job.h"
 
 class IEntity;
+class TaskScheduler;
 struct RenderState;
 
 struct SceneLighting {
@@ -24,12 +28,28 @@ class Scene {
 	void on_unload ();
 
 	void update (float dt_ms, float sim_time_ms);
-	void collect_drawables (RenderState& out_render_state);
+	void collect_drawables (RenderState& out_render_state, float alpha = 1.0f);
+	// The hierarchy as the editor shows it while the simulation runs ahead.
+	void collect_entities (RenderState& out_render_state) const;
 
 	void add_entity (std::unique_ptr<IEntity> entity);
+	// Children of a removed entity become roots.
+	bool remove_entity (const std::string& name);
+	SceneCommandStats apply_commands ();
 
 	std::unordered_map<std::string, std::unique_ptr<IEntity>> scene_entities;
 	std::unique_ptr<CameraManager> camera_manager;
+	TaskScheduler* task_scheduler = nullptr;
+
+	// Work tied to this scene. Unloading cancels it and waits for it alone,
+	// not for the whole scheduler.
+	TaskGroup task_group;
+
+	// Structural changes recorded by jobs, applied by apply_commands ().
+	SceneCommands commands;
+	// Every fixed-step update, starting with the built-in history, entity
+	// and wave systems; non-conflicting ones run concurrently.
+	SceneSystems systems;
 
   private:
 	bool loaded = false;
@@ -0,0 +1,104 @@
+#include "systems.h"
+
+#include <chrono>
+
+#include "runtime/tasks/tasks.h"
+
+namespace {
+bool overlaps (
+	const std::vector<std::type_index>& a,
+	const std::vector<std::type_index>& b
+) {
+	for (const std::type_index& type : a)
+		if (std::find (b.begin (), b.end (), type) != b.end ())
+			return true;
+	return false;
+}
+} // namespace
+
+bool SystemAccess::conflicts (const SystemAccess& other) const {
+	return exclusive || other.exclusive || overlaps (writes, other.writes)
+		   || overlaps (writes, other.reads) || overlaps (reads, other.writes);
+}
+
+size_t SceneSystems::add (
+	std::string name, SystemAccess access, SceneSystem system
+) {
+	systems.push_back (
+		{std::move (name), std::move (access), std::move (system)}
+	);
+	dirty = true;
+	return systems.size () - 1;
+}
+
+const std::vector<std::vector<size_t>>& SceneSystems::get_waves () {
+	if (dirty)
+		build_waves ();
+	return waves;
+}
+
+void SceneSystems::build_waves () {
+	std::vector<size_t> wave_of (systems.size (), 0);
+	waves.clear ();
+
+	for (size_t i = 0; i < systems.size (); ++i) {
+		for (size_t earlier = 0; earlier < i; ++earlier)
+			if (systems[i].access.conflicts (systems[earlier].access))
+				wave_of[i] = std::max (wave_of[i], wave_of[earlier] + 1);
+
+		if (wave_of[i] >= waves.size ())
+			waves.resize (wave_of[i] + 1);
+		waves[wave_of[i]].push_back (i);
+	}
+	dirty = false;
+}
+
+void SceneSystems::run (
+	Scene& scene, const float dt_ms, const float sim_time_ms,
+	TaskScheduler* task_scheduler
+) {
+	using clock = std::chrono::steady_clock;
+
+	if (systems.empty ())
+		return;
+
+	const auto& wave_list = get_waves ();
+	const auto start = clock::now ();
+	const auto since_start = [start] () {
+		return std::chrono::duration<float, std::milli> (clock::now () - start)
+			.count ();
+	};
+
+	runs.resize (systems.size ());
+	size_t next_run = 0;
+
+	for (size_t wave = 0; wave < wave_list.size (); ++wave) {
+		const std::vector<size_t>& members = wave_list[wave];
+		const size_t first_run = next_run;
+		next_run += members.size ();
+
+		const auto run_range = [&] (const size_t begin, const size_t end) {
+			for (size_t i = begin; i < end; ++i) {
+				SystemRun& record = runs[first_run + i];
+				record.system = members[i];
+				record.wave = wave;
+				record.start_ms = since_start ();
+				systems[members[i]].system (scene, dt_ms, sim_time_ms);
+				record.end_ms = since_start ();
+			}
+		};
+
+		if (task_scheduler && members.size () > 1)
+			task_scheduler->parallel_for (0, members.size (), 1, run_range);
+		else
+			run_range (0, members.size ());
+	}
+
+	std::lock_guard lock (last_run_mutex);
+	last_run.assign (runs.begin (), runs.end ());
+}
+
+void SceneSystems::copy_last_run (std::vector<SystemRun>& out) const {
+	std::lock_guard lock (last_run_mutex);
+	out.assign (last_run.begin (), last_run.end ());
+}
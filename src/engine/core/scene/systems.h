@@ -0,0 +1,85 @@
+#ifndef SCENE_SYSTEMS_H
+#define SCENE_SYSTEMS_H
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <typeindex>
+#include <vector>
+
+class Scene;
+class TaskScheduler;
+
+// Component types a system reads and writes. Two systems conflict when
+// either one writes a type the other touches; exclusive systems conflict
+// with everything.
+struct SystemAccess {
+	std::vector<std::type_index> reads;
+	std::vector<std::type_index> writes;
+	bool exclusive = false;
+
+	template <typename... Components> SystemAccess& read () {
+		(reads.emplace_back (typeid (Components)), ...);
+		return *this;
+	}
+	template <typename... Components> SystemAccess& write () {
+		(writes.emplace_back (typeid (Components)), ...);
+		return *this;
+	}
+
+	[[nodiscard]] bool conflicts (const SystemAccess& other) const;
+};
+
+using SceneSystem
+	= std::function<void (Scene& scene, float dt_ms, float sim_time_ms)>;
+
+struct SystemRun {
+	size_t system = 0;
+	size_t wave = 0;
+	float start_ms = 0.0f;
+	float end_ms = 0.0f;
+};
+
+// Runs scene systems every fixed step. Each system lands in the first wave
+// after every earlier system it conflicts with, so results match running
+// them in registration order. The systems of one wave run concurrently and
+// waves run one after another.
+class SceneSystems {
+  public:
+	size_t add (std::string name, SystemAccess access, SceneSystem system);
+
+	void run (
+		Scene& scene, float dt_ms, float sim_time_ms,
+		TaskScheduler* task_scheduler
+	);
+
+	[[nodiscard]] const std::vector<std::vector<size_t>>& get_waves ();
+	[[nodiscard]] const std::string& get_name (const size_t system) const {
+		return systems[system].name;
+	}
+	[[nodiscard]] size_t size () const { return systems.size (); }
+
+	// The most recent run, safe to read while the next one is in flight.
+	void copy_last_run (std::vector<SystemRun>& out) const;
+
+  private:
+	struct Entry {
+		std::string name;
+		SystemAccess access;
+		SceneSystem system;
+	};
+
+	void build_waves ();
+
+	std::vector<Entry> systems;
+	std::vector<std::vector<size_t>> waves;
+	bool dirty = false;
+
+	std::vector<SystemRun> runs;
+	std::vector<SystemRun> last_run;
+	mutable std::mutex last_run_mutex;
+};
+
+#endif // SCENE_SYSTEMS_H
@@ -0,0 +1,25 @@
+#ifndef BUDGET_H
+#define BUDGET_H
+
+#include <concepts>
+#include <cstdint>
+
+#include "core/storage/storage.h"
+
+// Factories that can report what a handle costs let Pool and Cache enforce
+// a byte budget. Handles of other factories count as zero bytes, so a
+// budget never evicts them.
+template <class Factory>
+concept SizedFactory = requires (const Factory& factory, Handle handle) {
+	{ factory.bytes (handle) } -> std::convertible_to<uint64_t>;
+};
+
+template <class Factory>
+uint64_t handle_bytes (const Factory& factory, const Handle handle) {
+	if constexpr (SizedFactory<Factory>)
+		return factory.bytes (handle);
+	else
+		return 0;
+}
+
+#endif // BUDGET_H
@@ -1,42 +1,133 @@
 #ifndef CACHE_H
 #define CACHE_H
 
+#include <cassert>
+#include <iterator>
+#include <list>
 #include <memory>
 #include <ranges>
 #include <unordered_map>
 
+#include "core/storage/lifetime/budget.h"
 #include "core/storage/state.h"
 #include "core/storage/storage.h"
 
+struct CacheStats {
+	uint64_t hits = 0;
+	uint64_t misses = 0;
+
+	uint64_t live_bytes = 0;
+	uint64_t evictions = 0;
+	uint64_t evicted_bytes = 0;
+};
+
+// One handle per distinct state. Each get_or_create () counts a user until
+// the matching release (). With a nonzero budget, entries nobody is using
+// are destroyed once the cached bytes exceed it, least recently released
+// first; an entry in use is never evicted, even over budget.
 template <class State, class Factory> class Cache {
   public:
-	explicit Cache (std::shared_ptr<Factory> factory)
-		: factory (std::move (factory)) {}
+	explicit Cache (
+		std::shared_ptr<Factory> factory, const uint64_t budget_bytes = 0
+	)
+		: factory (std::move (factory)), budget_bytes (budget_bytes) {}
 
 	Handle get_or_create (const State& state) {
-		IStateKey<State> key (state);
+		const IStateProbe<State> probe (state);
 
-		if (const auto it = instances.find (key); it != instances.end ())
-			return it->second;
+		if (const auto it = instances.find (probe); it != instances.end ()) {
+			stats.hits++;
+			Entry& entry = it->second;
+			if (entry.users++ == 0) {
+				recency.erase (entry.recency);
+				entry.recency = recency.end ();
+			}
+			return entry.handle;
+		}
 
+		stats.misses++;
 		Handle created = factory->create (state);
-		instances.emplace (std::move (key), created);
+		const uint64_t bytes = handle_bytes (*factory, created);
+
+		instances.try_emplace (
+			Key (probe), Entry{created, bytes, 1, recency.end ()}
+		);
+		stats.live_bytes += bytes;
+
+		evict_to_budget ();
 		return created;
 	}
 
+	// Drops one user; an entry with none left becomes evictable.
+	void release (const State& state) {
+		const auto it = instances.find (IStateProbe<State> (state));
+		assert (it != instances.end () && it->second.users > 0);
+		if (it == instances.end () || it->second.users == 0)
+			return;
+
+		Entry& entry = it->second;
+		if (--entry.users == 0) {
+			recency.push_back (&it->first);
+			entry.recency = std::prev (recency.end ());
+			evict_to_budget ();
+		}
+	}
+
+	void set_budget (const uint64_t bytes) {
+		budget_bytes = bytes;
+		evict_to_budget ();
+	}
+
 	void clear () {
-		for (const auto& handle : instances | std::views::values) {
-			factory->destroy (handle);
+		for (const auto& entry : instances | std::views::values) {
+			factory->destroy (entry.handle);
 		}
 		instances.clear ();
+		recency.clear ();
+		stats.live_bytes = 0;
 	}
 
+	[[nodiscard]] const CacheStats& get_stats () const { return stats; }
+
   private:
+	using Key = IStateKey<State>;
+
+	struct Entry {
+		Handle handle;
+		uint64_t bytes = 0;
+		uint32_t users = 0;
+		// Into recency while users is zero, recency.end () otherwise.
+		typename std::list<const Key*>::iterator recency;
+	};
+
+	void evict_to_budget () {
+		if (budget_bytes == 0)
+			return;
+
+		while (stats.live_bytes > budget_bytes && !recency.empty ()) {
+			const auto it = instances.find (*recency.front ());
+			factory->destroy (it->second.handle);
+
+			stats.evictions++;
+			stats.evicted_bytes += it->second.bytes;
+			stats.live_bytes -= it->second.bytes;
+
+			recency.pop_front ();
+			instances.erase (it);
+		}
+	}
+
 	std::shared_ptr<Factory> factory;
+	uint64_t budget_bytes = 0;
+
+	// Unused entries, least recently released first; points at keys inside
+	// instances, whose nodes never move.
+	std::list<const Key*> recency;
 	std::unordered_map<
-		IStateKey<State>, Handle, typename IStateKey<State>::Hash,
-		typename IStateKey<State>::Equals>
+		Key, Entry, typename Key::Hash, typename Key::Equals>
 		instances;
+
+	CacheStats stats{};
 };
 
 #endif // CACHE_H
@@ -1,10 +1,13 @@
 #ifndef POOL_H
 #define POOL_H
 
+#include <algorithm>
+#include <iterator>
 #include <ranges>
 #include <unordered_map>
 #include <vector>
 
+#include "core/storage/lifetime/budget.h"
 #include "core/storage/state.h"
 #include "core/storage/storage.h"
 
@@ -25,6 +28,12 @@ struct PoolStats {
 	uint64_t peak_free_handles = 0;
 
 	uint64_t clear_calls = 0;
+
+	uint64_t free_bytes = 0;
+	uint64_t evictions = 0;
+	uint64_t evicted_bytes = 0;
+
+	uint64_t in_flight_misses = 0;
 };
 
 struct PoolBucketStats {
@@ -36,40 +45,70 @@ struct PoolBucketStats {
 	uint32_t peak_free = 0;
 };
 
+// Recycles handles by state. With a nonzero budget, released handles are
+// kept only while their bytes fit it; past that the least recently released
+// ones are destroyed, and buckets they leave empty are dropped together with
+// their PoolBucketStats. Stale states, such as old window sizes, therefore
+// do not pile up; a state seen again starts a fresh bucket with zeroed
+// stats. PoolStats keeps the pool-wide totals across evictions.
+//
+// A handle released during a frame is not handed out again until end_frame
+// reports that frame complete, since the GPU may still be using it. Without
+// frame calls every release is immediately reusable.
 template <class State, class Factory> class Pool {
   public:
-	explicit Pool (Factory& factory) : factory (factory) {}
-
-	Handle acquire (const State& state) {
-		stats.acquire_calls++;
+	explicit Pool (Factory& factory, const uint64_t budget_bytes = 0)
+		: factory (factory), budget_bytes (budget_bytes) {}
 
-		IStateKey<State> key (state);
-		auto [it, inserted] = buckets.try_emplace (std::move (key), Bucket{});
-
-		if (inserted) {
-			stats.live_buckets++;
-			if (stats.live_buckets > stats.peak_buckets)
-				stats.peak_buckets = stats.live_buckets;
-		}
-
-		Bucket& bucket = it->second;
+	void set_budget (const uint64_t bytes) {
+		budget_bytes = bytes;
+		evict_to_budget ();
+	}
+	[[nodiscard]] uint64_t get_budget () const { return budget_bytes; }
 
-		if (!bucket.free.empty ()) {
-			const Handle handle = bucket.free.back ();
-			bucket.free.pop_back ();
+	void begin_frame (const uint64_t frame) { current_frame = frame; }
+	void end_frame (const uint64_t frame) {
+		completed_frame = std::max (completed_frame, frame);
+	}
 
-			stats.hits++;
-			++bucket.stats.hits;
+	Handle acquire (const State& state) {
+		stats.acquire_calls++;
 
-			stats.free_handles--;
-			bucket.stats.free = static_cast<uint32_t> (bucket.free.size ());
+		// Only release () creates buckets, so states that are acquired but
+		// never released leave nothing behind.
+		auto it = buckets.find (IStateProbe<State> (state));
+		if (it != buckets.end ()) {
+			Bucket& bucket = it->second;
+
+			// Release frames never decrease, so reusable handles are a
+			// prefix.
+			const auto reusable = std::ranges::partition_point (
+				bucket.free, [&] (const FreeHandle& free) {
+					return free.frame <= completed_frame;
+				}
+			);
+
+			if (reusable != bucket.free.begin ()) {
+				const auto warmest = std::prev (reusable);
+				const FreeHandle free = *warmest;
+				bucket.free.erase (warmest);
+
+				stats.hits++;
+				++bucket.stats.hits;
+
+				stats.free_handles--;
+				stats.free_bytes -= free.bytes;
+				bucket.stats.free = static_cast<uint32_t> (bucket.free.size ());
+
+				return free.handle;
+			}
 
-			return handle;
+			++bucket.stats.misses;
+			if (!bucket.free.empty ())
+				stats.in_flight_misses++;
 		}
 
 		stats.misses++;
-		++bucket.stats.misses;
-
 		stats.creates++;
 		return factory.create (state);
 	}
@@ -77,34 +116,31 @@ template <class State, class Factory> class Pool {
 	void release (const State& state, const Handle handle) {
 		stats.release_calls++;
 
-		IStateKey<State> key (state);
-		auto [it, inserted] = buckets.try_emplace (std::move (key), Bucket{});
-
-		if (inserted) {
-			stats.live_buckets++;
-			if (stats.live_buckets > stats.peak_buckets)
-				stats.peak_buckets = stats.live_buckets;
-		}
-
-		Bucket& bucket = it->second;
-		bucket.free.push_back (handle);
+		Bucket& bucket = bucket_for (state);
+		const uint64_t bytes = handle_bytes (factory, handle);
+		bucket.free.push_back (
+			{handle, bytes, ++release_tick, current_frame}
+		);
 
 		++bucket.stats.releases;
 		stats.free_handles++;
+		stats.free_bytes += bytes;
 		if (stats.free_handles > stats.peak_free_handles)
 			stats.peak_free_handles = stats.free_handles;
 
 		bucket.stats.free = static_cast<uint32_t> (bucket.free.size ());
 		if (bucket.stats.free > bucket.stats.peak_free)
 			bucket.stats.peak_free = bucket.stats.free;
+
+		evict_to_budget ();
 	}
 
 	void clear () {
 		stats.clear_calls++;
 
 		for (auto& bucket : buckets | std::views::values) {
-			for (const auto handle : bucket.free) {
-				factory.destroy (handle);
+			for (const FreeHandle& free : bucket.free) {
+				factory.destroy (free.handle);
 				stats.destroys++;
 			}
 		}
@@ -112,35 +148,100 @@ template <class State, class Factory> class Pool {
 		buckets.clear ();
 
 		stats.free_handles = 0;
+		stats.free_bytes = 0;
 		stats.live_buckets = 0;
 	}
 
 	[[nodiscard]] const PoolStats& get_stats () const { return stats; }
 
+	// Null for states without a bucket, including ones evicted empty.
 	[[nodiscard]] const PoolBucketStats*
 	get_bucket_stats (const State& state) const {
-		IStateKey<State> key (state);
-		auto it = buckets.find (key);
+		auto it = buckets.find (IStateProbe<State> (state));
 		if (it == buckets.end ())
 			return nullptr;
 		return &it->second.stats;
 	}
 
 	[[nodiscard]] uint32_t get_bucket_free_count (const State& state) const {
-		IStateKey<State> key (state);
-		auto it = buckets.find (key);
+		auto it = buckets.find (IStateProbe<State> (state));
 		if (it == buckets.end ())
 			return 0;
 		return static_cast<uint32_t> (it->second.free.size ());
 	}
 
   private:
+	struct FreeHandle {
+		Handle handle;
+		uint64_t bytes = 0;
+		uint64_t released = 0;
+		uint64_t frame = 0;
+	};
+
+	// Oldest release first, so acquire () takes the warmest reusable handle
+	// and eviction takes the front.
 	struct Bucket {
-		std::vector<Handle> free;
+		std::vector<FreeHandle> free;
 		PoolBucketStats stats{};
 	};
 
+	// Probes with the borrowed state; only a new bucket clones it.
+	Bucket& bucket_for (const State& state) {
+		const IStateProbe<State> probe (state);
+		if (auto it = buckets.find (probe); it != buckets.end ())
+			return it->second;
+
+		stats.live_buckets++;
+		if (stats.live_buckets > stats.peak_buckets)
+			stats.peak_buckets = stats.live_buckets;
+
+		return buckets.emplace (IStateKey<State> (probe), Bucket{})
+			.first->second;
+	}
+
+	// Buckets are few, so finding the oldest front by scanning beats
+	// keeping a global recency list up to date on every release.
+	void evict_to_budget () {
+		if (budget_bytes == 0)
+			return;
+
+		while (stats.free_bytes > budget_bytes) {
+			auto oldest = buckets.end ();
+			for (auto it = buckets.begin (); it != buckets.end (); ++it) {
+				const std::vector<FreeHandle>& free = it->second.free;
+				if (!free.empty ()
+					&& (oldest == buckets.end ()
+						|| free.front ().released
+							   < oldest->second.free.front ().released))
+					oldest = it;
+			}
+			if (oldest == buckets.end ())
+				return;
+
+			Bucket& bucket = oldest->second;
+			const FreeHandle victim = bucket.free.front ();
+			bucket.free.erase (bucket.free.begin ());
+			factory.destroy (victim.handle);
+
+			stats.destroys++;
+			stats.evictions++;
+			stats.evicted_bytes += victim.bytes;
+			stats.free_bytes -= victim.bytes;
+			stats.free_handles--;
+			bucket.stats.free = static_cast<uint32_t> (bucket.free.size ());
+
+			if (bucket.free.empty ()) {
+				buckets.erase (oldest);
+				stats.live_buckets--;
+			}
+		}
+	}
+
 	Factory& factory;
+	uint64_t budget_bytes = 0;
+	uint64_t release_tick = 0;
+	uint64_t current_frame = 0;
+	uint64_t completed_frame = 0;
 
 	std::unordered_map<
 		IStateKey<State>, Bucket, typename IStateKey<State>::Hash,
@@ -0,0 +1,66 @@
+#ifndef RETIRE_H
+#define RETIRE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <utility>
+
+struct RetireStats {
+	uint64_t retired = 0;
+	uint64_t collected = 0;
+
+	uint64_t pending = 0;
+	uint64_t peak_pending = 0;
+};
+
+// Holds values until the frame that last used them has completed on the
+// GPU. Frames only move forward, so the queue stays sorted and collecting
+// is a walk from the front.
+template <class T> class RetireQueue {
+  public:
+	void retire (const uint64_t frame, T value) {
+		entries.push_back ({frame, std::move (value)});
+
+		stats.retired++;
+		stats.pending = entries.size ();
+		if (stats.pending > stats.peak_pending)
+			stats.peak_pending = stats.pending;
+	}
+
+	// Hands every value retired at or before completed_frame to function,
+	// oldest first.
+	template <class Function>
+	size_t collect (const uint64_t completed_frame, Function&& function) {
+		size_t count = 0;
+		while (!entries.empty () && entries.front ().frame <= completed_frame) {
+			T value = std::move (entries.front ().value);
+			entries.pop_front ();
+			function (value);
+			++count;
+		}
+
+		stats.collected += count;
+		stats.pending = entries.size ();
+		return count;
+	}
+
+	template <class Function> size_t flush (Function&& function) {
+		return collect (UINT64_MAX, std::forward<Function> (function));
+	}
+
+	[[nodiscard]] bool empty () const { return entries.empty (); }
+	[[nodiscard]] size_t size () const { return entries.size (); }
+	[[nodiscard]] const RetireStats& get_stats () const { return stats; }
+
+  private:
+	struct Entry {
+		uint64_t frame = 0;
+		T value;
+	};
+
+	std::deque<Entry> entries;
+	RetireStats stats{};
+};
+
+#endif // RETIRE_H
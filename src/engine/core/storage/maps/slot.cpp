@@ -1,4 +1,6 @@
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 
 #include "slot.h"
 
@@ -7,7 +9,7 @@ DenseSlotMapStorage::slot_if_valid (const Handle handle) {
 	if (!handle.valid () || handle.id >= slots.size ())
 		return nullptr;
 	Slot& slot = slots[handle.id];
-	if (!slot.occupied || slot.gen != handle.generation)
+	if (slot.dense == no_record || slot.gen != handle.generation)
 		return nullptr;
 	return &slot;
 }
@@ -17,7 +19,7 @@ DenseSlotMapStorage::slot_if_valid (const Handle handle) const {
 	if (!handle.valid () || handle.id >= slots.size ())
 		return nullptr;
 	const Slot& slot = slots[handle.id];
-	if (!slot.occupied || slot.gen != handle.generation)
+	if (slot.dense == no_record || slot.gen != handle.generation)
 		return nullptr;
 	return &slot;
 }
@@ -30,6 +32,7 @@ Handle DenseSlotMapStorage::allocate (
 		record_align = align;
 	}
 	assert (size == record_size && align == record_align);
+	assert (align <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
 
 	uint32_t id;
 	if (!free_ids.empty ()) {
@@ -38,23 +41,23 @@ Handle DenseSlotMapStorage::allocate (
 	} else {
 		id = static_cast<uint32_t> (slots.size ());
 		slots.push_back (Slot{});
-		data.resize (slots.size () * record_size);
-		stats.bytes_reserved = data.size ();
 	}
 
-	auto& [gen, occupied] = slots[id];
-	occupied = true;
+	// Grown geometrically, so live records move only on doubling.
+	const size_t dense = dense_ids.size ();
+	if ((dense + 1) * record_size > data.size ())
+		data.resize (std::max (initial_records, dense * 2) * record_size);
 
-	stats.allocations++;
-	stats.live++;
-	if (stats.live > stats.peak_live)
-		stats.peak_live = stats.live;
+	std::memset (&data[dense * record_size], 0, record_size);
+	dense_ids.push_back (id);
 
-	stats.capacity = static_cast<uint32_t> (slots.size ());
-	stats.free_list = static_cast<uint32_t> (free_ids.size ());
-	stats.bytes_live = static_cast<uint64_t> (stats.live) * record_size;
+	Slot& slot = slots[id];
+	slot.dense = static_cast<uint32_t> (dense);
+
+	stats.allocations++;
+	update_stats ();
 
-	return Handle{id, gen};
+	return Handle{id, slot.gen};
 }
 
 bool DenseSlotMapStorage::free (const Handle handle) {
@@ -62,17 +65,23 @@ bool DenseSlotMapStorage::free (const Handle handle) {
 	if (!slot)
 		return false;
 
-	slot->occupied = false;
+	const uint32_t hole = slot->dense;
+	const auto last = static_cast<uint32_t> (dense_ids.size () - 1);
+	if (hole != last) {
+		std::memcpy (
+			&data[hole * record_size], &data[last * record_size], record_size
+		);
+		dense_ids[hole] = dense_ids[last];
+		slots[dense_ids[hole]].dense = hole;
+	}
+	dense_ids.pop_back ();
+
+	slot->dense = no_record;
 	slot->gen += 1;
 	free_ids.push_back (handle.id);
 
 	stats.frees++;
-	if (stats.live > 0)
-		stats.live--;
-
-	stats.capacity = static_cast<uint32_t> (slots.size ());
-	stats.free_list = static_cast<uint32_t> (free_ids.size ());
-	stats.bytes_live = static_cast<uint64_t> (stats.live) * record_size;
+	update_stats ();
 
 	return true;
 }
@@ -82,23 +91,42 @@ bool DenseSlotMapStorage::valid (const Handle handle) const {
 }
 
 void* DenseSlotMapStorage::try_get (const Handle handle) {
-	if (const Slot* slot = slot_if_valid (handle); !slot)
+	const Slot* slot = slot_if_valid (handle);
+	if (!slot)
 		return nullptr;
-	return &data[handle.id * record_size];
+	return &data[slot->dense * record_size];
 }
 
 const void* DenseSlotMapStorage::try_get (const Handle handle) const {
-	if (const Slot* slot = slot_if_valid (handle); !slot)
+	const Slot* slot = slot_if_valid (handle);
+	if (!slot)
 		return nullptr;
-	return &data[handle.id * record_size];
+	return &data[slot->dense * record_size];
+}
+
+Handle DenseSlotMapStorage::handle_at (const size_t dense) const {
+	assert (dense < dense_ids.size ());
+	const uint32_t id = dense_ids[dense];
+	return Handle{id, slots[id].gen};
 }
 
 void DenseSlotMapStorage::clear () {
 	slots.clear ();
 	free_ids.clear ();
+	dense_ids.clear ();
 	data.clear ();
 	record_size = 0;
 	record_align = 0;
 
 	stats = {};
-}
\ No newline at end of file
+}
+
+void DenseSlotMapStorage::update_stats () {
+	stats.live = static_cast<uint32_t> (dense_ids.size ());
+	stats.peak_live = std::max (stats.peak_live, stats.live);
+
+	stats.capacity = static_cast<uint32_t> (slots.size ());
+	stats.free_list = static_cast<uint32_t> (free_ids.size ());
+	stats.bytes_reserved = data.size ();
+	stats.bytes_live = static_cast<uint64_t> (stats.live) * record_size;
+}
@@ -1,7 +1,11 @@
 #ifndef SLOT_H
 #define SLOT_H
 
+#include <cassert>
 #include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
 #include <vector>
 
 #include "core/storage/storage.h"
@@ -19,6 +23,11 @@ struct DenseSlotMapStats {
 	uint64_t bytes_live = 0;
 };
 
+// Slot ids index a sparse table that points into a packed array of live
+// records, so records() is a contiguous range with no holes. Freeing swaps
+// the last record into the hole, which moves it with memcpy: records must be
+// trivially relocatable, and pointers from try_get () only last until the
+// next allocate () or free ().
 class DenseSlotMapStorage final : public IStorage {
   public:
 	DenseSlotMapStorage () = default;
@@ -34,16 +43,30 @@ class DenseSlotMapStorage final : public IStorage {
 
 	void clear ();
 
+	[[nodiscard]] size_t size () const { return dense_ids.size (); }
+
+	// Live records in dense order; handle_at (i) is the handle of the i-th.
+	template <class T> [[nodiscard]] std::span<T> records () {
+		static_assert (std::is_trivially_copyable_v<T>);
+		assert (dense_ids.empty () || sizeof (T) == record_size);
+		return {reinterpret_cast<T*> (data.data ()), dense_ids.size ()};
+	}
+	[[nodiscard]] Handle handle_at (size_t dense) const;
+
 	[[nodiscard]] const DenseSlotMapStats& get_stats () const { return stats; }
 
   private:
+	static constexpr uint32_t no_record = 0xFFFFFFFFu;
+	static constexpr size_t initial_records = 16;
+
 	struct Slot {
 		uint32_t gen = 0;
-		bool occupied = false;
+		uint32_t dense = no_record;
 	};
 
 	std::vector<Slot> slots;
 	std::vector<uint32_t> free_ids;
+	std::vector<uint32_t> dense_ids;
 	std::vector<std::byte> data;
 
 	std::size_t record_size = 0;
@@ -53,6 +76,7 @@ class DenseSlotMapStorage final : public IStorage {
 
 	Slot* slot_if_valid (Handle handle);
 	[[nodiscard]] const Slot* slot_if_valid (Handle handle) const;
+	void update_stats ();
 };
 
 #endif // SLOT_H
@@ -0,0 +1,160 @@
+#ifndef SLOT_MAP_H
+#define SLOT_MAP_H
+
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "core/storage/maps/slot.h"
+#include "core/storage/storage.h"
+
+// Typed, packed counterpart of DenseSlotMapStorage. Values are constructed
+// in place and move on swap-remove or when the backing vector grows, so a
+// pointer from get () is invalidated by any emplace () or erase (); hold
+// the Handle instead. get () is inline, so a lookup is a bounds check, a
+// generation compare and a load. The IStorage overrides let type-erased
+// factories keep working: allocate () default-constructs a value and must
+// be asked for exactly sizeof (T) and alignof (T). Virtual functions cannot
+// carry their own constraint, so the whole map requires a default
+// initializable T.
+template <class T>
+	requires std::default_initializable<T>
+class SlotMap final : public IStorage {
+  public:
+	static constexpr std::size_t record_size = sizeof (T);
+	static constexpr std::size_t record_align = alignof (T);
+
+	template <class... Args> Handle emplace (Args&&... args) {
+		uint32_t id;
+		if (!free_ids.empty ()) {
+			id = free_ids.back ();
+			free_ids.pop_back ();
+		} else {
+			id = static_cast<uint32_t> (slots.size ());
+			slots.push_back (Slot{});
+		}
+
+		values.emplace_back (std::forward<Args> (args)...);
+		dense_ids.push_back (id);
+
+		Slot& slot = slots[id];
+		slot.dense = static_cast<uint32_t> (values.size () - 1);
+
+		stats.allocations++;
+		update_stats ();
+		return Handle{id, slot.gen};
+	}
+
+	bool erase (const Handle handle) {
+		Slot* slot = slot_if_valid (handle);
+		if (!slot)
+			return false;
+
+		const uint32_t hole = slot->dense;
+		if (hole != values.size () - 1) {
+			values[hole] = std::move (values.back ());
+			dense_ids[hole] = dense_ids.back ();
+			slots[dense_ids[hole]].dense = hole;
+		}
+		values.pop_back ();
+		dense_ids.pop_back ();
+
+		slot->dense = no_record;
+		slot->gen += 1;
+		free_ids.push_back (handle.id);
+
+		stats.frees++;
+		update_stats ();
+		return true;
+	}
+
+	[[nodiscard]] T* get (const Handle handle) {
+		const Slot* slot = slot_if_valid (handle);
+		return slot ? &values[slot->dense] : nullptr;
+	}
+	[[nodiscard]] const T* get (const Handle handle) const {
+		const Slot* slot = slot_if_valid (handle);
+		return slot ? &values[slot->dense] : nullptr;
+	}
+
+	[[nodiscard]] bool contains (const Handle handle) const {
+		return slot_if_valid (handle) != nullptr;
+	}
+
+	[[nodiscard]] std::span<T> records () { return values; }
+	[[nodiscard]] std::span<const T> records () const { return values; }
+	[[nodiscard]] Handle handle_at (const std::size_t dense) const {
+		const uint32_t id = dense_ids[dense];
+		return Handle{id, slots[id].gen};
+	}
+	[[nodiscard]] std::size_t size () const { return values.size (); }
+
+	void clear () {
+		slots.clear ();
+		free_ids.clear ();
+		dense_ids.clear ();
+		values.clear ();
+		stats = {};
+	}
+
+	[[nodiscard]] const DenseSlotMapStats& get_stats () const { return stats; }
+
+	Handle allocate (const std::size_t size, const std::size_t align) override {
+		assert (size == record_size && align == record_align);
+		return emplace ();
+	}
+
+	bool free (const Handle handle) override { return erase (handle); }
+
+	[[nodiscard]] bool valid (const Handle handle) const override {
+		return contains (handle);
+	}
+
+	void* try_get (const Handle handle) override { return get (handle); }
+	[[nodiscard]] const void* try_get (const Handle handle) const override {
+		return get (handle);
+	}
+
+  private:
+	static constexpr uint32_t no_record = 0xFFFFFFFFu;
+
+	struct Slot {
+		uint32_t gen = 0;
+		uint32_t dense = no_record;
+	};
+
+	[[nodiscard]] const Slot* slot_if_valid (const Handle handle) const {
+		if (handle.id >= slots.size ())
+			return nullptr;
+		const Slot& slot = slots[handle.id];
+		if (slot.dense == no_record || slot.gen != handle.generation)
+			return nullptr;
+		return &slot;
+	}
+	Slot* slot_if_valid (const Handle handle) {
+		return const_cast<Slot*> (std::as_const (*this).slot_if_valid (handle));
+	}
+
+	void update_stats () {
+		stats.live = static_cast<uint32_t> (values.size ());
+		stats.peak_live = std::max (stats.peak_live, stats.live);
+		stats.capacity = static_cast<uint32_t> (slots.size ());
+		stats.free_list = static_cast<uint32_t> (free_ids.size ());
+		stats.bytes_reserved = values.capacity () * record_size;
+		stats.bytes_live = values.size () * record_size;
+	}
+
+	std::vector<Slot> slots;
+	std::vector<uint32_t> free_ids;
+	std::vector<uint32_t> dense_ids;
+	std::vector<T> values;
+
+	DenseSlotMapStats stats{};
+};
+
+#endif // SLOT_MAP_H
@@ -1,6 +1,7 @@
 #ifndef STATE_H
 #define STATE_H
 
+#include <cstddef>
 #include <memory>
 
 template <class T> struct IState {
@@ -11,27 +12,61 @@ template <class T> struct IState {
 	[[nodiscard]] virtual std::unique_ptr<T> clone () const = 0;
 };
 
+// Borrowed state with its hash computed once, used to probe maps keyed by
+// IStateKey without cloning. Must not outlive the state it points to.
+template <class T> struct IStateProbe {
+	explicit IStateProbe (const T& state)
+		: state (&state), hash (state.hash ()) {}
+
+	const T* state;
+	size_t hash;
+};
+
 template <class T> struct IStateKey {
 	std::unique_ptr<T> state;
+	size_t hash = 0;
 
-	explicit IStateKey (const T& state) : state (state.clone ()) {}
+	explicit IStateKey (const T& state)
+		: IStateKey (IStateProbe<T> (state)) {}
+	explicit IStateKey (const IStateProbe<T>& probe)
+		: state (probe.state->clone ()), hash (probe.hash) {}
 
 	IStateKey (IStateKey&&) noexcept = default;
 	IStateKey& operator= (IStateKey&&) noexcept = default;
 	IStateKey (const IStateKey&) = delete;
 	IStateKey& operator= (const IStateKey&) = delete;
 
+	// Transparent, so find () accepts an IStateProbe. Hashes are compared
+	// before the virtual equals ().
 	struct Hash {
+		using is_transparent = void;
+
 		size_t operator() (const IStateKey& key) const noexcept {
-			return key.state->hash ();
+			return key.hash;
+		}
+		size_t operator() (const IStateProbe<T>& probe) const noexcept {
+			return probe.hash;
 		}
 	};
 
 	struct Equals {
+		using is_transparent = void;
+
 		bool operator() (
 			const IStateKey& key_a, const IStateKey& key_b
 		) const noexcept {
-			return key_a.state->equals (*key_b.state);
+			return key_a.hash == key_b.hash
+				   && key_a.state->equals (*key_b.state);
+		}
+		bool operator() (
+			const IStateKey& key, const IStateProbe<T>& probe
+		) const noexcept {
+			return key.hash == probe.hash && key.state->equals (*probe.state);
+		}
+		bool operator() (
+			const IStateProbe<T>& probe, const IStateKey& key
+		) const noexcept {
+			return (*this) (key, probe);
 		}
 	};
 };
@@ -45,6 +45,9 @@ void EditorManager::create_ui (
 
 	EditorContext editor_context{
 		.window = &docked_panel_class,
+		.task_telemetry = task_telemetry,
+		.clock = clock,
+		.render_states = render_states,
 		.texture_registry = texture_registry,
 		.render_state = render_state,
 		.editor_state = editor_state,
@@ -13,6 +13,9 @@ class TextureTarget;
 struct RenderState;
 class BufferManager;
 class IEntity;
+struct TaskSchedulerTelemetry;
+class Clock;
+class RenderStateBuffer;
 
 enum EditorMode { Editing, Running };
 
@@ -35,6 +38,9 @@ struct EditorContext {
 	RenderState& render_state;
 	TextureRegistry& texture_registry;
 	ImGuiWindowClass* window = nullptr;
+	const TaskSchedulerTelemetry* task_telemetry = nullptr;
+	const Clock* clock = nullptr;
+	const RenderStateBuffer* render_states = nullptr;
 };
 
 class EditorManager {
@@ -47,6 +53,9 @@ class EditorManager {
 
 	std::vector<std::unique_ptr<IEditorPanel>> panels;
 	EditorState editor_state;
+	const TaskSchedulerTelemetry* task_telemetry = nullptr;
+	const Clock* clock = nullptr;
+	const RenderStateBuffer* render_states = nullptr;
 };
 
 #endif // EDITOR_H
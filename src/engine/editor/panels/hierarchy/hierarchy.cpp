@@ -68,13 +68,77 @@ void Hierarchy::draw_entity_node (IEntity& entity, EditorState& editor_state) {
 	ImGui::PopStyleVar ();
 }
 
+size_t Hierarchy::draw_entity_view (
+	const std::span<const EntityView> entities, const size_t index,
+	EditorState& editor_state
+) {
+	const EntityView& view = entities[index];
+	const size_t end = index + view.subtree_size;
+	const bool is_leaf = view.subtree_size == 1;
+
+	ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_OpenOnArrow
+							   | ImGuiTreeNodeFlags_SpanFullWidth
+							   | ImGuiTreeNodeFlags_FramePadding;
+
+	if (is_leaf) {
+		flags |= ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_NoTreePushOnOpen;
+	}
+
+	ImGui::PushStyleVar (ImGuiStyleVar_IndentSpacing, 8.0f);
+
+	if (editor_state.selected_entity == view.entity)
+		flags |= ImGuiTreeNodeFlags_Selected;
+
+	const bool tree_pushed
+		= ImGui::TreeNodeEx (view.entity, flags, "%s", view.name.c_str ())
+		  && !is_leaf;
+
+	// Only the view is read; the live entity may be mid-update.
+	if (ImGui::IsItemClicked ()
+		&& editor_state.selected_entity != view.entity) {
+		editor_state.selected_entity = view.entity;
+		editor_state.cached_rotation_euler[view.entity]
+			= view.transform.rotation;
+	}
+
+	if (tree_pushed) {
+		size_t child = index + 1;
+		while (child < end)
+			child = draw_entity_view (entities, child, editor_state);
+		ImGui::TreePop ();
+	}
+
+	ImGui::PopStyleVar ();
+	return end;
+}
+
 void Hierarchy::draw (EditorContext& editor_context) {
 	ImGui::SetNextWindowClass (editor_context.window);
 	ImGui::Begin ("Hierarchy", nullptr, ImGuiWindowFlags_NoCollapse);
 
-	Scene& scene = *editor_context.render_state.scene;
 	auto& state = editor_context.editor_state;
 
+	// While running, the simulation is updating the live entities.
+	if (state.editor_mode == Running) {
+		const std::span<const EntityView> entities
+			= editor_context.render_state.entities;
+
+		if (!state.selected_entity && !entities.empty ()) {
+			state.selected_entity = entities.front ().entity;
+			state.cached_rotation_euler[state.selected_entity]
+				= entities.front ().transform.rotation;
+		}
+
+		size_t index = 0;
+		while (index < entities.size ())
+			index = draw_entity_view (entities, index, state);
+
+		ImGui::End ();
+		return;
+	}
+
+	Scene& scene = *editor_context.render_state.scene;
+
 	if (!state.selected_entity) {
 		for (const auto& e : scene.scene_entities | std::views::values) {
 			if (!e->parent) {
@@ -3,13 +3,23 @@
 
 #include "editor/panels/panel.h"
 
+#include <cstddef>
+#include <span>
+
 struct EditorState;
+struct EntityView;
 class IEntity;
 
 class Hierarchy final : public IEditorPanel {
   public:
 	void draw (EditorContext& editor_context) override;
 	void draw_entity_node (IEntity& entity, EditorState& editor_state);
+	// Draws entities[index] from a snapshot and returns the index past its
+	// subtree.
+	size_t draw_entity_view (
+		std::span<const EntityView> entities, size_t index,
+		EditorState& editor_state
+	);
 };
 
 #endif // HIERARCHY_H
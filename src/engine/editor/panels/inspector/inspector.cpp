@@ -3,8 +3,38 @@
 #include "editor/editor.h"
 #include "entity/entity.h"
 #include "imgui.h"
+#include "render/snapshot.h"
 #include "utils.h"
 
+// Read-only: while running, the live entity is being simulated.
+static void draw_view (const EntityView& view) {
+	ImGui::Text ("Entity");
+	ImGui::Separator ();
+	ImGui::Text ("Name: %s", view.name.c_str ());
+
+	ImGui::Spacing ();
+
+	ImGui::Text ("Transform");
+	ImGui::Separator ();
+
+	const Transform& transform = view.transform;
+	ImGui::Text (
+		"Position: %.2f %.2f %.2f", transform.position.x,
+		transform.position.y, transform.position.z
+	);
+	ImGui::Text (
+		"Scale: %.2f %.2f %.2f", transform.scale.x, transform.scale.y,
+		transform.scale.z
+	);
+	ImGui::Text (
+		"Rotation: %.2f %.2f %.2f", transform.rotation.x,
+		transform.rotation.y, transform.rotation.z
+	);
+
+	ImGui::Spacing ();
+	ImGui::TextDisabled ("Switch to editing to change it");
+}
+
 void Inspector::draw (EditorContext& editor_context) {
 	ImGui::SetNextWindowClass (editor_context.window);
 	ImGui::Begin ("Inspector", nullptr, ImGuiWindowFlags_NoCollapse);
@@ -18,6 +48,20 @@ void Inspector::draw (EditorContext& editor_context) {
 		return;
 	}
 
+	if (state.editor_mode == Running) {
+		const EntityView* selected = nullptr;
+		for (const EntityView& view : editor_context.render_state.entities)
+			if (view.entity == entity)
+				selected = &view;
+
+		if (selected)
+			draw_view (*selected);
+		else
+			ImGui::TextDisabled ("Selected entity is gone");
+		ImGui::End ();
+		return;
+	}
+
 	ImGui::Text ("Entity");
 	ImGui::Separator ();
 
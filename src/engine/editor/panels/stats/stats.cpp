@@ -1,7 +1,123 @@
 #include "stats.h"
 
+#include <cstdio>
+
+#include "core/memory/allocations.h"
 #include "editor/editor.h"
 #include "imgui.h"
+#include "render/render.h"
+#include "runtime/clock.h"
+#include "runtime/tasks/telemetry.h"
+#include "scene.h"
+
+namespace {
+void draw_worker (const char* name, const WorkerUtilization& worker) {
+	ImGui::Text (
+		"%s: %3.0f%%  %5.2f ms busy  %llu jobs", name,
+		worker.utilization * 100.0f, worker.busy_ms,
+		static_cast<unsigned long long> (worker.jobs)
+	);
+}
+
+void draw_histogram (const char* name, const LatencyHistogram& histogram) {
+	ImGui::Text (
+		"%s p50/p95/p99: %.1f / %.1f / %.1f us", name,
+		histogram.percentile_us (0.50f), histogram.percentile_us (0.95f),
+		histogram.percentile_us (0.99f)
+	);
+}
+
+const char* pacing_name (const FramePacing pacing) {
+	switch (pacing) {
+	case FramePacing::Sleep:
+		return "sleep";
+	case FramePacing::Hybrid:
+		return "hybrid";
+	case FramePacing::Spin:
+		return "spin";
+	}
+	return "";
+}
+
+// Deviation of each frame from the target frame time.
+void draw_pacing (const Clock& clock) {
+	const FrameJitter jitter = clock.get_jitter ();
+	ImGui::Text (
+		"Jitter (%s) p50/p95/p99: %.2f / %.2f / %.2f ms",
+		pacing_name (clock.pacing), jitter.p50_ms, jitter.p95_ms,
+		jitter.p99_ms
+	);
+}
+
+// Time from publishing a snapshot to the renderer picking it up.
+void draw_handoff (const RenderStateBuffer& render_states) {
+	const RenderStateStats stats = render_states.get_stats ();
+	ImGui::Text (
+		"Snapshot handoff: %.2f ms (max %.2f)", stats.last_handoff_ms,
+		stats.max_handoff_ms
+	);
+	ImGui::Text (
+		"Snapshots: %llu published, %llu skipped, %llu repeated",
+		static_cast<unsigned long long> (stats.published),
+		static_cast<unsigned long long> (stats.skipped),
+		static_cast<unsigned long long> (stats.repeated)
+	);
+}
+
+void draw_tasks (const TaskSchedulerTelemetry& telemetry) {
+	ImGui::Separator ();
+	ImGui::Text ("Workers (%zu)", telemetry.workers.size ());
+
+	char name[32];
+	for (size_t i = 0; i < telemetry.workers.size (); ++i) {
+		const WorkerUtilization& worker = telemetry.workers[i];
+		snprintf (
+			name, sizeof (name), "%s %zu",
+			worker.worker_class == WorkerClass::Latency ? "worker" : "bg", i
+		);
+		draw_worker (name, worker);
+	}
+	draw_worker ("caller", telemetry.caller);
+
+	ImGui::Text (
+		"Queued: %lld latency, %lld background",
+		static_cast<long long> (telemetry.queue_depth[0]),
+		static_cast<long long> (telemetry.queue_depth[1])
+	);
+	draw_histogram ("Queue wait", telemetry.queue_wait);
+	draw_histogram ("Run time", telemetry.run_time);
+}
+
+// One line per wave; systems on the same line ran concurrently.
+void draw_systems (SceneSystems& systems, std::vector<SystemRun>& runs) {
+	systems.copy_last_run (runs);
+	if (runs.empty ())
+		return;
+
+	ImGui::Separator ();
+	ImGui::Text ("Systems (%zu waves)", runs.back ().wave + 1);
+
+	size_t wave = runs.front ().wave;
+	std::string line;
+	char entry[96];
+	for (size_t i = 0; i <= runs.size (); ++i) {
+		if (i == runs.size () || runs[i].wave != wave) {
+			ImGui::Text ("%zu:%s", wave, line.c_str ());
+			if (i == runs.size ())
+				break;
+			wave = runs[i].wave;
+			line.clear ();
+		}
+
+		const SystemRun& run = runs[i];
+		snprintf (
+			entry, sizeof (entry), " %s %.2f-%.2f",
+			systems.get_name (run.system).c_str (), run.start_ms, run.end_ms
+		);
+		line += entry;
+	}
+}
+} // namespace
 
 void Stats::draw (EditorContext& editor_context) {
 	ImGui::SetNextWindowClass (editor_context.window);
@@ -14,5 +130,32 @@ void Stats::draw (EditorContext& editor_context) {
 
 	ImGui::Text ("FPS: %.1f", fps);
 	ImGui::Text ("Frame: %.2f ms", ms);
+	if (editor_context.clock)
+		draw_pacing (*editor_context.clock);
+
+	// Counts every thread, so it includes the editor's own allocations.
+	const uint64_t heap_allocations = get_heap_allocations ();
+	ImGui::Text (
+		"Heap allocations: %llu/frame",
+		static_cast<unsigned long long> (
+			heap_allocations - last_heap_allocations
+		)
+	);
+	last_heap_allocations = heap_allocations;
+
+	const FrameArena& arena = editor_context.render_state.arena;
+	ImGui::Text (
+		"Frame arena: %.1f / %.1f KB", arena.used () / 1024.0f,
+		arena.size () / 1024.0f
+	);
+
+	if (editor_context.render_states)
+		draw_handoff (*editor_context.render_states);
+	if (editor_context.task_telemetry)
+		draw_tasks (*editor_context.task_telemetry);
+	if (editor_context.render_state.scene)
+		draw_systems (
+			editor_context.render_state.scene->systems, system_runs
+		);
 	ImGui::End ();
 }
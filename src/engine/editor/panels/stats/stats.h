@@ -2,10 +2,18 @@
 #define STATS_H
 
 #include "editor/panels/panel.h"
+#include "systems.h"
+
+#include <cstdint>
+#include <vector>
 
 class Stats final : public IEditorPanel {
   public:
 	void draw (EditorContext& editor_context) override;
+
+  private:
+	std::vector<SystemRun> system_runs;
+	uint64_t last_heap_allocations = 0;
 };
 
 #endif // STATS_H
@@ -253,6 +253,10 @@ static ImRect draw_texture_registry_debug_box_top_right (
 	char value_pool_peak_buckets[32];
 	char value_pool_free_handles[32];
 	char value_pool_peak_free_handles[32];
+	char value_pool_free_bytes[32];
+	char value_pool_evictions[32];
+	char value_pool_in_flight_misses[32];
+	char value_retired_pending[32];
 
 	std::snprintf (
 		value_pool_acquire_calls, sizeof (value_pool_acquire_calls), "%llu",
@@ -294,6 +298,22 @@ static ImRect draw_texture_registry_debug_box_top_right (
 		value_pool_peak_free_handles, sizeof (value_pool_peak_free_handles),
 		"%llu", static_cast<unsigned long long> (snap.pool.peak_free_handles)
 	);
+	format_bytes (
+		value_pool_free_bytes, sizeof (value_pool_free_bytes),
+		snap.pool.free_bytes
+	);
+	std::snprintf (
+		value_pool_evictions, sizeof (value_pool_evictions), "%llu",
+		static_cast<unsigned long long> (snap.pool.evictions)
+	);
+	std::snprintf (
+		value_pool_in_flight_misses, sizeof (value_pool_in_flight_misses),
+		"%llu", static_cast<unsigned long long> (snap.pool.in_flight_misses)
+	);
+	std::snprintf (
+		value_retired_pending, sizeof (value_retired_pending), "%llu",
+		static_cast<unsigned long long> (snap.retired.pending)
+	);
 
 	const RegistryLine lines[] = {
 		{"Viewport", nullptr},
@@ -325,6 +345,10 @@ static ImRect draw_texture_registry_debug_box_top_right (
 		{"Peak Buckets", value_pool_peak_buckets},
 		{"Free Cached", value_pool_free_handles},
 		{"Peak Cached", value_pool_peak_free_handles},
+		{"Cached Bytes", value_pool_free_bytes},
+		{"Evictions", value_pool_evictions},
+		{"In Flight Misses", value_pool_in_flight_misses},
+		{"Pending Frees", value_retired_pending},
 	};
 
 	float maximum_key_width = 0.0f;
@@ -20,6 +20,7 @@
 #include <imgui_impl_sdlgpu3.h>
 
 #include <iostream>
+#include <ranges>
 
 #include "render/textures/registry.h"
 
@@ -81,9 +82,18 @@ Engine::Engine () {
 	);
 
 	runtime = std::make_unique<Runtime> ();
+	render_states = std::make_unique<RenderStateBuffer> ();
+
+	editor_manager->task_telemetry = &runtime->task_scheduler.get_telemetry ();
+	editor_manager->render_states = render_states.get ();
 }
 
 Engine::~Engine () {
+	// Retired GPU resources are released through the device, so drain them
+	// before it goes.
+	if (render)
+		render->shutdown ();
+
 	SDL_DestroyGPUDevice (gpu_device);
 	SDL_DestroyWindow (window);
 	SDL_Quit ();
@@ -265,6 +275,7 @@ void Engine::run () {
 
 	runtime->task_scheduler.start ();
 	Clock clock (60);
+	render->editor_manager->clock = &clock;
 
 	IMGUI_CHECKVERSION ();
 	ImGui::CreateContext ();
@@ -306,6 +317,8 @@ void Engine::run () {
 
 	ImGui_ImplSDLGPU3_Init (&init_info);
 
+	TaskGroup simulation;
+
 	while (running) {
 		commit_scene_change ();
 		float dt = clock.begin_frame ();
@@ -329,6 +342,12 @@ void Engine::run () {
 						= (editor.editor_state.editor_mode == Editing)
 							  ? Running
 							  : Editing;
+
+					// A selection made from a snapshot may name an entity
+					// destroyed since; editing dereferences it.
+					if (editor.editor_state.editor_mode == Editing
+						&& active_scene)
+						forget_destroyed_selection ();
 				}
 				if (e.key.key == SDL_GetKeyFromName ("R")) {
 					int window_width = 0, window_height = 0;
@@ -366,36 +385,91 @@ void Engine::run () {
 			request_scene (std::move (scene));
 		}
 
+		int steps = 0;
 		while (clock.should_step_simulation ()) {
-			runtime->update (clock.fixed_dt_ms);
+			clock.consume_simulation_step ();
+			++steps;
+		}
 
-			if (active_scene)
-				active_scene->update (
-					clock.fixed_dt_ms, runtime->simulation_time_ms
-				);
+		runtime->task_scheduler.submit (
+			[this, steps, fixed_dt_ms = clock.fixed_dt_ms,
+			 alpha = clock.alpha ()] () {
+				simulate (steps, fixed_dt_ms, alpha);
+			},
+			simulation
+		);
 
-			clock.consume_simulation_step ();
+		// While running, the previous snapshot is rendered as the next one is
+		// simulated, and the editor only shows the snapshot's entity view.
+		// Editing mutates live entities, so it stays in lockstep.
+		const bool pipelined = render->editor_manager->editor_state.editor_mode
+							   == Running;
+		if (!pipelined || !render_states->has_snapshot ())
+			runtime->task_scheduler.wait (simulation, WaitMode::Help);
+
+		if (RenderState* state = render_states->acquire ()) {
+			render->prepare_frame (*state);
+			render->render (
+				*state, keyboard_input, mouse_input, state->simulation_time_ms
+			);
 		}
 
-		RenderState state{};
-		state.scene = active_scene.get ();
-		if (active_scene)
-			active_scene->collect_drawables (state);
+		runtime->task_scheduler.wait (simulation, WaitMode::Help);
 
-		render->render (
-			state, keyboard_input, mouse_input, runtime->simulation_time_ms
-		);
+		// Simulation and rendering are joined, so structural changes recorded
+		// by jobs can be applied without locking the scene.
+		if (active_scene && active_scene->apply_commands ().destroyed > 0)
+			forget_destroyed_selection ();
 
+		// Incremental work only gets the slack left after simulation and
+		// rendering, so it never delays the next frame.
+		runtime->run_incremental (clock.remaining_frame_ms ());
+		runtime->task_scheduler.end_frame ();
 		clock.end_frame ();
 	}
 
+	runtime->join ();
 	runtime->task_scheduler.stop ();
 }
 
+void Engine::simulate (
+	const int steps, const float fixed_dt_ms, const float alpha
+) {
+	for (int i = 0; i < steps; ++i) {
+		runtime->update (fixed_dt_ms);
+
+		if (active_scene)
+			active_scene->update (fixed_dt_ms, runtime->simulation_time_ms);
+	}
+
+	runtime->join ();
+
+	RenderState& state = render_states->write_slot ();
+	state.begin_frame ();
+	state.scene = active_scene.get ();
+	state.simulation_time_ms = runtime->simulation_time_ms;
+	if (active_scene) {
+		active_scene->collect_drawables (state, alpha);
+		active_scene->collect_entities (state);
+	}
+
+	render_states->publish ();
+}
+
 void Engine::request_scene (std::unique_ptr<Scene> in_scene) {
 	pending_scene = std::move (in_scene);
 }
 
+void Engine::forget_destroyed_selection () const {
+	EditorState& editor = render->editor_manager->editor_state;
+	editor.cached_rotation_euler.clear ();
+
+	for (const auto& entity : active_scene->scene_entities | std::views::values)
+		if (entity.get () == editor.selected_entity)
+			return;
+	editor.selected_entity = nullptr;
+}
+
 void Engine::commit_scene_change () {
 	if (!pending_scene)
 		return;
@@ -404,7 +478,10 @@ void Engine::commit_scene_change () {
 		active_scene->on_unload ();
 
 	active_scene = std::move (pending_scene);
+	render_states->reset ();
 
-	if (active_scene)
+	if (active_scene) {
+		active_scene->task_scheduler = &runtime->task_scheduler;
 		active_scene->on_load ();
+	}
 }
@@ -8,6 +8,7 @@
 
 class AssetManager;
 class RenderManager;
+class RenderStateBuffer;
 class Runtime;
 class Scene;
 
@@ -28,8 +29,12 @@ class Engine {
 	std::unique_ptr<Runtime> runtime;
 	std::unique_ptr<RenderManager> render;
 	std::unique_ptr<AssetManager> asset;
+	std::unique_ptr<RenderStateBuffer> render_states;
 
   private:
+	void simulate (int steps, float fixed_dt_ms, float alpha);
+	void forget_destroyed_selection () const;
+
 	SDL_GPUDevice* gpu_device = nullptr;
 	SDL_Window* window = nullptr;
 
@@ -4,6 +4,7 @@
 #include "drawable.h"
 
 #include <SDL3/SDL.h>
+#include <memory_resource>
 #include <vector>
 
 class TextureRegistry;
@@ -22,7 +23,7 @@ struct RenderContext {
 
 	TextureRegistry* texture_registry = nullptr;
 
-	std::vector<Drawable>* drawables = nullptr;
+	std::pmr::vector<Drawable>* drawables = nullptr;
 	SDL_GPURenderPass* render_pass = nullptr;
 
 	float time = 0.0f;
@@ -4,16 +4,42 @@
 #include "memory.h"
 
 #include <glm/glm.hpp>
+#include <memory_resource>
+#include <utility>
 #include <vector>
 
 struct Buffer;
 struct MeshInstance;
 struct MaterialInstance;
 
+// Allocator-aware, so inside a RenderState its instance blocks come from
+// the same frame arena as the drawable itself.
 struct Drawable {
+	using allocator_type = std::pmr::polymorphic_allocator<>;
+
+	Drawable () = default;
+	explicit Drawable (const allocator_type& allocator)
+		: instance_blocks (allocator) {}
+	Drawable (const Drawable& other, const allocator_type& allocator)
+		: mesh (other.mesh), material (other.material),
+		  instance_blocks (other.instance_blocks, allocator),
+		  model (other.model), instance_buffer (other.instance_buffer),
+		  index_buffer (other.index_buffer),
+		  vertex_buffer (other.vertex_buffer) {}
+	Drawable (Drawable&& other, const allocator_type& allocator)
+		: mesh (other.mesh), material (other.material),
+		  instance_blocks (std::move (other.instance_blocks), allocator),
+		  model (other.model), instance_buffer (other.instance_buffer),
+		  index_buffer (other.index_buffer),
+		  vertex_buffer (other.vertex_buffer) {}
+	Drawable (const Drawable&) = default;
+	Drawable (Drawable&&) = default;
+	Drawable& operator= (const Drawable&) = default;
+	Drawable& operator= (Drawable&&) = default;
+
 	MeshInstance* mesh = nullptr;
 	MaterialInstance* material = nullptr;
-	std::vector<Block> instance_blocks;
+	std::pmr::vector<Block> instance_blocks;
 	glm::mat4 model = {1.0f};
 
 	Buffer* instance_buffer = nullptr;
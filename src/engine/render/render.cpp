@@ -62,6 +62,36 @@ RenderManager::RenderManager (
 
 RenderManager::~RenderManager () = default;
 
+void RenderManager::retire_completed_frames () {
+	while (!in_flight.empty ()
+		   && SDL_QueryGPUFence (device, in_flight.front ().fence)) {
+		completed_frame = in_flight.front ().frame;
+		SDL_ReleaseGPUFence (device, in_flight.front ().fence);
+		in_flight.pop_front ();
+	}
+
+	texture_registry->end_frame (completed_frame);
+	retired_textures.collect (completed_frame, [&] (SDL_GPUTexture* texture) {
+		SDL_ReleaseGPUTexture (device, texture);
+	});
+}
+
+// Waits for every frame in flight and frees everything retired. Must run
+// while the device is still alive.
+void RenderManager::shutdown () {
+	for (const InFlightFrame& in_flight_frame : in_flight) {
+		SDL_WaitForGPUFences (device, true, &in_flight_frame.fence, 1);
+		SDL_ReleaseGPUFence (device, in_flight_frame.fence);
+	}
+	in_flight.clear ();
+
+	completed_frame = frame;
+	texture_registry->end_frame (completed_frame);
+	retired_textures.flush ([&] (SDL_GPUTexture* texture) {
+		SDL_ReleaseGPUTexture (device, texture);
+	});
+}
+
 void RenderManager::load_shaders () const {
 	const std::string shader_base = SHADERS_DIR;
 
@@ -154,14 +184,14 @@ void RenderManager::setup_render_graph () {
 	assert (RenderPasses::DeferredPass.execute);
 }
 
+// Frames still in flight may sample the old targets, so they are retired
+// rather than released and the GPU is never drained here.
 void RenderManager::resize (const int new_width, const int new_height) {
-	SDL_WaitForGPUIdle (device);
-
 	const int width = (new_width > 0) ? new_width : 2;
 	const int height = (new_height > 0) ? new_height : 2;
 
 	if (buffer_manager->depth_texture) {
-		SDL_ReleaseGPUTexture (device, buffer_manager->depth_texture);
+		retired_textures.retire (frame, buffer_manager->depth_texture);
 		buffer_manager->depth_texture = nullptr;
 	}
 
@@ -189,21 +219,17 @@ void RenderManager::acquire_swap_chain () {
 	buffer_manager->swap_chain_texture = swap_chain_texture;
 }
 
-void RenderManager::prepare_drawables (std::vector<Drawable>& drawables) const {
+void RenderManager::prepare_drawables (
+	std::pmr::vector<Drawable>& drawables
+) const {
 	for (Drawable& drawable : drawables) {
 		assert (drawable.mesh);
 		assert (&drawable.instance_blocks);
 
 		// --- Instance buffer ---
 		if (drawable.instance_blocks.empty ()) {
-			std::vector<Block> instance_blocks;
-			instance_blocks.reserve (1);
-
-			Block block{};
-			write_mat4 (block, drawable.model);
-
-			instance_blocks.push_back (block);
-			drawable.instance_blocks = std::move (instance_blocks);
+			drawable.instance_blocks.resize (1);
+			write_mat4 (drawable.instance_blocks[0], drawable.model);
 		}
 
 		drawable.instance_buffer
@@ -242,12 +268,13 @@ void RenderManager::prepare_drawables (std::vector<Drawable>& drawables) const {
 	}
 }
 
-void RenderManager::render (
-	RenderState& render_state, const KeyboardInput& key_board_input,
-	MouseInput& mouse_input, float delta_time
-) {
+// Only touches the snapshot, so it may overlap the next simulation step.
+void RenderManager::prepare_frame (RenderState& render_state) {
 	assert (&render_state);
 
+	retire_completed_frames ();
+	texture_registry->begin_frame (++frame);
+
 	buffer_manager->command_buffer = SDL_AcquireGPUCommandBuffer (device);
 	assert (buffer_manager->command_buffer);
 
@@ -255,6 +282,16 @@ void RenderManager::render (
 	assert (buffer_manager->swap_chain_texture);
 
 	prepare_drawables (render_state.drawables);
+}
+
+// While running, this overlaps the next simulation step: the editor then
+// reads only render_state's entity view, and the camera is touched by this
+// thread alone. While editing, the simulation must have joined.
+void RenderManager::render (
+	RenderState& render_state, const KeyboardInput& key_board_input,
+	MouseInput& mouse_input, float delta_time
+) {
+	assert (buffer_manager->command_buffer);
 
 	RenderContext render_context{
 		.camera_manager = render_state.scene->camera_manager.get (),
@@ -292,7 +329,10 @@ void RenderManager::render (
 
 	render_graph.execute_all (render_context);
 
-	SDL_SubmitGPUCommandBuffer (buffer_manager->command_buffer);
+	if (SDL_GPUFence* fence = SDL_SubmitGPUCommandBufferAndAcquireFence (
+			buffer_manager->command_buffer
+		))
+		in_flight.push_back ({frame, fence});
 
 	texture_registry->viewport.swap ();
 
@@ -1,12 +1,15 @@
 #ifndef RENDERER_H
 #define RENDERER_H
 
+#include "core/storage/lifetime/retire.h"
 #include "drawable.h"
 #include "graph/graph.h"
 #include "scene.h"
+#include "snapshot.h"
 
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_gpu.h>
+#include <deque>
 #include <imgui.h>
 #include <vector>
 
@@ -36,11 +39,6 @@ struct UniformBinding {
 	ShaderStage stage;
 };
 
-struct RenderState {
-	std::vector<Drawable> drawables;
-	Scene* scene;
-};
-
 class RenderManager {
   public:
 	RenderManager (
@@ -54,6 +52,7 @@ class RenderManager {
 		std::shared_ptr<TextureRegistry> texture_registry
 	);
 	~RenderManager ();
+	void shutdown ();
 	void setup_render_graph ();
 	void resize (int new_width, int new_height);
 	void acquire_swap_chain ();
@@ -72,6 +71,7 @@ class RenderManager {
 
 	std::shared_ptr<TextureRegistry> texture_registry;
 
+	void prepare_frame (RenderState& render_state);
 	void render (
 		RenderState& render_state, const KeyboardInput& key_board_input,
 		MouseInput& mouse_input, float delta_time
@@ -81,14 +81,28 @@ class RenderManager {
 	void create_gbuffer_textures (int width, int height) const;
 	void destroy_gbuffer_textures () const;
 
-	void prepare_drawables (std::vector<Drawable>& drawables) const;
+	void prepare_drawables (std::pmr::vector<Drawable>& drawables) const;
 
   private:
+	struct InFlightFrame {
+		uint64_t frame = 0;
+		SDL_GPUFence* fence = nullptr;
+	};
+
+	void retire_completed_frames ();
+
 	SDL_GPUDevice* device = nullptr;
 	SDL_Window* window = nullptr;
 	SDL_GPURenderPass* current_render_pass = nullptr;
 
 	RenderGraph render_graph;
+
+	// Frames are numbered from 1; a resource retired during frame N is
+	// freed once the fence submitted with frame N has signalled.
+	uint64_t frame = 0;
+	uint64_t completed_frame = 0;
+	std::deque<InFlightFrame> in_flight;
+	RetireQueue<SDL_GPUTexture*> retired_textures;
 };
 
 #endif // RENDERER_H
@@ -0,0 +1,75 @@
+#include "snapshot.h"
+
+#include <algorithm>
+
+void RenderState::begin_frame () {
+	// Everything the vectors own points into the arena, so drop it first.
+	drawables = std::pmr::vector<Drawable> (&arena);
+	entities = std::pmr::vector<EntityView> (&arena);
+	arena.reset ();
+}
+
+void RenderStateBuffer::publish () {
+	publish_times[write_index] = clock::now ();
+
+	const uint8_t previous = ready.exchange (
+		write_index | fresh, std::memory_order_acq_rel
+	);
+	if (previous & fresh)
+		skipped.fetch_add (1, std::memory_order_relaxed);
+
+	write_index = previous & index_mask;
+	published.fetch_add (1, std::memory_order_relaxed);
+}
+
+RenderState* RenderStateBuffer::acquire () {
+	if (!(ready.load (std::memory_order_relaxed) & fresh)) {
+		if (!has_read)
+			return nullptr;
+
+		repeated++;
+		return &slots[read_index];
+	}
+
+	const uint8_t previous = ready.exchange (
+		read_index, std::memory_order_acq_rel
+	);
+	read_index = previous & index_mask;
+	has_read = true;
+	consumed++;
+
+	last_handoff_ms = std::chrono::duration<float, std::milli> (
+						  clock::now () - publish_times[read_index]
+	)
+						  .count ();
+	max_handoff_ms = std::max (max_handoff_ms, last_handoff_ms);
+
+	return &slots[read_index];
+}
+
+bool RenderStateBuffer::has_snapshot () const {
+	return has_read || (ready.load (std::memory_order_acquire) & fresh);
+}
+
+void RenderStateBuffer::reset () {
+	for (RenderState& slot : slots) {
+		slot.begin_frame ();
+		slot.scene = nullptr;
+	}
+
+	write_index = 0;
+	read_index = 1;
+	ready.store (2, std::memory_order_release);
+	has_read = false;
+}
+
+RenderStateStats RenderStateBuffer::get_stats () const {
+	RenderStateStats out{};
+	out.published = published.load (std::memory_order_relaxed);
+	out.skipped = skipped.load (std::memory_order_relaxed);
+	out.consumed = consumed;
+	out.repeated = repeated;
+	out.last_handoff_ms = last_handoff_ms;
+	out.max_handoff_ms = max_handoff_ms;
+	return out;
+}
@@ -0,0 +1,109 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "core/memory/frame_arena.h"
+#include "drawable.h"
+#include "entity/entity.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+class Scene;
+
+// What the editor shows of one entity while the simulation runs ahead.
+// entity identifies it for selection only; it may be destroyed by the time
+// the snapshot is drawn, so it is never dereferenced through the view.
+// Entries are depth first, so a node's subtree is the subtree_size entries
+// starting at it.
+struct EntityView {
+	using allocator_type = std::pmr::polymorphic_allocator<>;
+
+	EntityView () = default;
+	explicit EntityView (const allocator_type& allocator) : name (allocator) {}
+	EntityView (const EntityView& other, const allocator_type& allocator)
+		: entity (other.entity), name (other.name, allocator),
+		  transform (other.transform), subtree_size (other.subtree_size) {}
+	EntityView (EntityView&& other, const allocator_type& allocator)
+		: entity (other.entity), name (std::move (other.name), allocator),
+		  transform (other.transform), subtree_size (other.subtree_size) {}
+	EntityView (const EntityView&) = default;
+	EntityView (EntityView&&) = default;
+	EntityView& operator= (const EntityView&) = default;
+	EntityView& operator= (EntityView&&) = default;
+
+	IEntity* entity = nullptr;
+	std::pmr::string name;
+	Transform transform;
+	uint32_t subtree_size = 1;
+};
+
+// Drawables, the entity view and everything they own live in the state's
+// own arena, which is rewound when the slot is refilled, not freed piece by
+// piece.
+struct RenderState {
+	FrameArena arena;
+	std::pmr::vector<Drawable> drawables{&arena};
+	std::pmr::vector<EntityView> entities{&arena};
+	Scene* scene = nullptr;
+	float simulation_time_ms = 0.0f;
+
+	void begin_frame ();
+};
+
+struct RenderStateStats {
+	uint64_t published = 0;
+	uint64_t consumed = 0;
+	uint64_t skipped = 0;
+	uint64_t repeated = 0;
+
+	float last_handoff_ms = 0.0f;
+	float max_handoff_ms = 0.0f;
+};
+
+// Triple-buffered RenderState. The simulation fills write_slot () and
+// publishes it while the renderer keeps reading the snapshot it acquired
+// last; slots and their drawable storage are reused, never reallocated.
+class RenderStateBuffer {
+  public:
+	RenderStateBuffer () = default;
+	RenderStateBuffer (const RenderStateBuffer&) = delete;
+	RenderStateBuffer& operator= (const RenderStateBuffer&) = delete;
+
+	RenderState& write_slot () { return slots[write_index]; }
+	void publish ();
+
+	RenderState* acquire ();
+	[[nodiscard]] bool has_snapshot () const;
+
+	void reset ();
+
+	[[nodiscard]] RenderStateStats get_stats () const;
+
+  private:
+	using clock = std::chrono::steady_clock;
+
+	static constexpr uint8_t fresh = 1 << 2;
+	static constexpr uint8_t index_mask = fresh - 1;
+
+	std::array<RenderState, 3> slots{};
+	std::array<clock::time_point, 3> publish_times{};
+
+	uint8_t write_index = 0;
+	uint8_t read_index = 1;
+	std::atomic<uint8_t> ready{2};
+	bool has_read = false;
+
+	std::atomic<uint64_t> published{0};
+	std::atomic<uint64_t> skipped{0};
+	uint64_t consumed = 0;
+	uint64_t repeated = 0;
+	float last_handoff_ms = 0.0f;
+	float max_handoff_ms = 0.0f;
+};
+
+#endif // SNAPSHOT_H
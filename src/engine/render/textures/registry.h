@@ -4,7 +4,7 @@
 #include "core/storage/lifetime/buffers/ring.h"
 #include "core/storage/lifetime/buffers/single.h"
 #include "core/storage/lifetime/pool.h"
-#include "core/storage/maps/slot.h"
+#include "core/storage/maps/slot_map.h"
 #include "core/storage/record.h"
 #include "core/storage/wrappers/target.h"
 #include "core/types.h"
@@ -14,6 +14,7 @@
 struct TextureDebugSnapshot {
 	DenseSlotMapStats storage{};
 	PoolStats pool{};
+	RetireStats retired{};
 
 	int viewport_width = 0;
 	int viewport_height = 0;
@@ -91,7 +92,12 @@ class TextureRegistry {
 		  gbuffer_position (storage, GBufferPositionEnsurer{}),
 		  gbuffer_normal (storage, GBufferNormalEnsurer{}),
 		  gbuffer_albedo (storage, GBufferAlbedoEnsurer{}),
-		  texture_factory (device, storage), texture_pool (texture_factory) {}
+		  texture_factory (device, storage),
+		  texture_pool (texture_factory, idle_texture_budget) {}
+
+	// Released textures kept for reuse; stale sizes left behind by window
+	// resizes are evicted once they exceed this.
+	static constexpr uint64_t idle_texture_budget = 128ull * 1024 * 1024;
 
 	Target<RingBuffer<Handle, 2>, ViewportEnsurer> viewport;
 
@@ -132,9 +138,7 @@ class TextureRegistry {
 				return;
 			}
 
-			const auto* record = static_cast<TextureRecord*> (
-				storage.try_get (handle)
-			);
+			const auto* record = storage.get (handle);
 			if (!record) {
 				return;
 			}
@@ -175,10 +179,20 @@ class TextureRegistry {
 		ensure_target (gbuffer_albedo, width, height);
 	}
 
+	// Textures released or destroyed while a frame is recorded are only
+	// reused or freed once end_frame reports that frame complete.
+	void begin_frame (const uint64_t frame) {
+		texture_factory.begin_frame (frame);
+		texture_pool.begin_frame (frame);
+	}
+
+	void end_frame (const uint64_t frame) {
+		texture_pool.end_frame (frame);
+		texture_factory.end_frame (frame);
+	}
+
 	SDL_GPUTexture* resolve_texture (const Handle handle) {
-		const auto* record = static_cast<TextureRecord*> (
-			storage.try_get (handle)
-		);
+		const auto* record = storage.get (handle);
 		return record ? record->tex : nullptr;
 	}
 
@@ -186,6 +200,7 @@ class TextureRegistry {
 		TextureDebugSnapshot out{};
 		out.storage = storage.get_stats ();
 		out.pool = texture_pool.get_stats ();
+		out.retired = texture_factory.retire_stats ();
 
 		out.viewport_width = viewport.width;
 		out.viewport_height = viewport.height;
@@ -201,9 +216,7 @@ class TextureRegistry {
 				return;
 			}
 
-			const auto* record = static_cast<const TextureRecord*> (
-				storage.try_get (handle)
-			);
+			const auto* record = storage.get (handle);
 			if (!record) {
 				return;
 			}
@@ -226,7 +239,7 @@ class TextureRegistry {
 	}
 
   private:
-	DenseSlotMapStorage storage;
+	SlotMap<TextureRecord> storage;
 	SDLTextureFactory texture_factory;
 	Pool<TextureState, SDLTextureFactory> texture_pool;
 };
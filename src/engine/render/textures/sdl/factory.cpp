@@ -71,31 +71,32 @@ Handle SDLTextureFactory::create (const TextureState& state) {
 	info.format = to_sdl_format (state.format);
 	info.usage = to_sdl_usage (state.usage);
 
-	const Handle handle = this->storage.allocate (
-		sizeof (TextureRecord), alignof (TextureRecord)
-	);
-	auto* record = static_cast<TextureRecord*> (this->storage.try_get (handle));
-	assert (record);
-
-	record->tex = SDL_CreateGPUTexture (device, &info);
-	assert (record->tex);
+	SDL_GPUTexture* texture = SDL_CreateGPUTexture (device, &info);
+	assert (texture);
 
-	record->state = state;
-	record->approx_bytes = estimate_bytes (state);
-	record->is_target = false;
-
-	return handle;
+	return records.emplace (
+		TextureRecord{texture, state, estimate_bytes (state), false}
+	);
 }
 
 void SDLTextureFactory::destroy (Handle handle) {
-	auto* record = static_cast<TextureRecord*> (this->storage.try_get (handle));
-	if (!record)
+	if (!records.contains (handle))
 		return;
 
-	if (record->tex) {
-		SDL_ReleaseGPUTexture (device, record->tex);
-		record->tex = nullptr;
-	}
+	retired.retire (current_frame, handle);
+}
+
+void SDLTextureFactory::end_frame (const uint64_t frame) {
+	retired.collect (frame, [&] (const Handle handle) {
+		TextureRecord* record = records.get (handle);
+		if (!record)
+			return;
+
+		if (record->tex) {
+			SDL_ReleaseGPUTexture (device, record->tex);
+			record->tex = nullptr;
+		}
 
-	this->storage.free (handle);
+		records.erase (handle);
+	});
 }
\ No newline at end of file
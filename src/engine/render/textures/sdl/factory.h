@@ -4,7 +4,9 @@
 #include <SDL3/SDL_gpu.h>
 
 #include "core/factory.h"
-#include "core/storage/maps/slot.h"
+#include "core/storage/lifetime/retire.h"
+#include "core/storage/maps/slot_map.h"
+#include "core/storage/record.h"
 #include "render/textures/texture.h"
 
 struct TextureState;
@@ -12,14 +14,35 @@ struct TextureRegistryStats;
 
 class SDLTextureFactory final : public IFactory<TextureState> {
   public:
-	SDLTextureFactory (SDL_GPUDevice* device, DenseSlotMapStorage& storage)
-		: IFactory (storage), device (device) {}
+	SDLTextureFactory (
+		SDL_GPUDevice* device, SlotMap<TextureRecord>& records
+	)
+		: IFactory (records), device (device), records (records) {}
 
 	Handle create (const TextureState& state) override;
+
+	// Destroyed textures stay alive until the frame that retired them has
+	// completed; end_frame releases them in one batch.
 	void destroy (Handle handle) override;
 
+	void begin_frame (const uint64_t frame) { current_frame = frame; }
+	void end_frame (uint64_t frame);
+
+	[[nodiscard]] const RetireStats& retire_stats () const {
+		return retired.get_stats ();
+	}
+
+	[[nodiscard]] uint64_t bytes (const Handle handle) const {
+		const TextureRecord* record = records.get (handle);
+		return record ? record->approx_bytes : 0;
+	}
+
   private:
 	SDL_GPUDevice* device = nullptr;
+	SlotMap<TextureRecord>& records;
+
+	RetireQueue<Handle> retired;
+	uint64_t current_frame = 0;
 
 	static uint32_t bytes_per_pixel (TextureFormat format);
 	static uint64_t estimate_bytes (const TextureState& state);
@@ -2,9 +2,24 @@
 #define CLOCK_H
 
 #include <algorithm>
+#include <array>
 #include <chrono>
+#include <cmath>
+#include <cstdint>
 #include <thread>
 
+enum class FramePacing : uint8_t {
+	Sleep,
+	Hybrid,
+	Spin,
+};
+
+struct FrameJitter {
+	float p50_ms = 0.0f;
+	float p95_ms = 0.0f;
+	float p99_ms = 0.0f;
+};
+
 class Clock {
 	using clock = std::chrono::high_resolution_clock;
 
@@ -12,6 +27,11 @@ class Clock {
 	float avg_fps = 0.0f;
 	float fixed_dt_ms;
 
+	// Hybrid pacing sleeps until spin_window_ms before the deadline and
+	// yields for the rest, which hides the OS wake-up overshoot.
+	FramePacing pacing = FramePacing::Hybrid;
+	float spin_window_ms = 2.0f;
+
 	explicit Clock (int target_fps, float fixed_dt_ms = 16.6667f)
 		: fixed_dt_ms (fixed_dt_ms), target_fps (target_fps),
 		  frame_delay_ms (1000.0f / target_fps) {
@@ -35,6 +55,11 @@ class Clock {
 		return dt;
 	}
 
+	void set_target_fps (const int fps) {
+		target_fps = fps;
+		frame_delay_ms = 1000.0f / fps;
+	}
+
 	void end_frame () {
 		auto frame_end = clock::now ();
 
@@ -48,7 +73,7 @@ class Clock {
 								   + std::chrono::microseconds (
 									   (int)(frame_delay_ms * 1000)
 								   );
-			std::this_thread::sleep_until (next_frame_time);
+			wait_until (next_frame_time);
 			frame_end = clock::now ();
 			frame_time_ms = std::chrono::duration<float, std::milli> (
 								frame_end - frame_start
@@ -56,10 +81,30 @@ class Clock {
 								.count ();
 		}
 
+		jitter_samples[jitter_sample_count % jitter_samples.size ()]
+			= std::abs (frame_time_ms - frame_delay_ms);
+		jitter_sample_count++;
+
 		accumulated_ms += frame_time_ms;
 		frame_count++;
 	}
 
+	[[nodiscard]] FrameJitter get_jitter () const {
+		const size_t count = std::min (
+			jitter_sample_count, jitter_samples.size ()
+		);
+		if (count == 0)
+			return {};
+
+		std::array<float, jitter_window> sorted = jitter_samples;
+		std::sort (sorted.begin (), sorted.begin () + count);
+
+		const auto at = [&] (const float percentile) {
+			return sorted[static_cast<size_t> (percentile * (count - 1))];
+		};
+		return {at (0.50f), at (0.95f), at (0.99f)};
+	}
+
 	bool should_log_stats () {
 		auto now = clock::now ();
 		if (std::chrono::duration_cast<std::chrono::seconds> (
@@ -77,6 +122,15 @@ class Clock {
 		return false;
 	}
 
+	// Time left before this frame reaches the target frame time.
+	[[nodiscard]] float remaining_frame_ms () const {
+		const float elapsed_ms = std::chrono::duration<float, std::milli> (
+									 clock::now () - frame_start
+		)
+									 .count ();
+		return std::max (0.0f, frame_delay_ms - elapsed_ms);
+	}
+
 	bool should_step_simulation () const {
 		return accumulator_ms >= fixed_dt_ms;
 	}
@@ -86,6 +140,30 @@ class Clock {
 	float alpha () const { return accumulator_ms / fixed_dt_ms; }
 
   private:
+	static constexpr size_t jitter_window = 256;
+
+	void wait_until (const clock::time_point deadline) const {
+		const auto spin_window = std::chrono::microseconds (
+			static_cast<int64_t> (spin_window_ms * 1000.0f)
+		);
+
+		switch (pacing) {
+		case FramePacing::Sleep:
+			std::this_thread::sleep_until (deadline);
+			return;
+		case FramePacing::Hybrid:
+			if (clock::now () < deadline - spin_window)
+				std::this_thread::sleep_until (deadline - spin_window);
+			while (clock::now () < deadline)
+				std::this_thread::yield ();
+			return;
+		case FramePacing::Spin:
+			while (clock::now () < deadline) {
+			}
+			return;
+		}
+	}
+
 	int target_fps;
 	float frame_delay_ms;
 	const float max_frame_dt_ms = 250.0f;
@@ -98,6 +176,9 @@ class Clock {
 
 	float accumulated_ms = 0.0f;
 	int frame_count = 0;
+
+	std::array<float, jitter_window> jitter_samples{};
+	size_t jitter_sample_count = 0;
 };
 
 #endif // CLOCK_H
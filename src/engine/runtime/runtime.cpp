@@ -1,11 +1,20 @@
 #include "runtime.h"
-#include "schedule/schedule.h"
+
+#include <algorithm>
 
 Runtime::Runtime () = default;
 
 void Runtime::update (const float delta_time_ms) {
 	simulation_time_ms += delta_time_ms;
-	for (Schedule& schedule : schedules) {
-		schedule.update (delta_time_ms, task_scheduler);
-	}
+	systems.update (delta_time_ms, task_scheduler);
+	timers.update (delta_time_ms, task_scheduler);
+}
+
+void Runtime::join () {
+	systems.join (task_scheduler);
+	timers.join (task_scheduler);
+}
+
+void Runtime::run_incremental (const float frame_slack_ms) {
+	incremental.run (std::min (incremental_budget_ms, frame_slack_ms));
 }
\ No newline at end of file
@@ -1,18 +1,29 @@
 #ifndef SIMULATION_H
 #define SIMULATION_H
 
-#include "schedule/schedule.h"
+#include "schedule/incremental.h"
+#include "schedule/systems.h"
 #include "tasks/tasks.h"
+#include "timers/timers.h"
 
 class Runtime {
   public:
 	Runtime ();
 	void update (float delta_time_ms);
+	void join ();
+
+	// Runs incremental jobs for at most incremental_budget_ms, and never
+	// longer than the slack left in the current frame.
+	void run_incremental (float frame_slack_ms);
 
 	TaskScheduler task_scheduler;
 
-	std::vector<Schedule> schedules;
+	SystemScheduler systems;
+	TimerWheel timers;
 	float simulation_time_ms = 0.0f;
+
+	IncrementalJobs incremental;
+	float incremental_budget_ms = 2.0f;
 };
 
 #endif // SIMULATION_H
@@ -0,0 +1,81 @@
+#include "incremental.h"
+
+#include <algorithm>
+
+uint64_t IncrementalJobs::add (IncrementalSlice slice) {
+	std::lock_guard lock (incoming_mutex);
+	const uint64_t id = next_id++;
+	incoming.push_back ({id, std::move (slice)});
+	return id;
+}
+
+void IncrementalJobs::run (const float budget_ms) {
+	using clock = std::chrono::steady_clock;
+
+	{
+		std::lock_guard lock (incoming_mutex);
+		for (Entry& entry : incoming)
+			jobs.push_back (std::move (entry));
+		incoming.clear ();
+	}
+
+	stats.last_used_ms = 0.0f;
+	if (jobs.empty () || budget_ms <= 0.0f)
+		return;
+
+	const auto start = now ();
+	const auto end = start
+					 + std::chrono::duration_cast<clock::duration> (
+						 std::chrono::duration<float, std::milli> (budget_ms)
+					 );
+
+	cursor %= jobs.size ();
+	size_t remaining = jobs.size ();
+
+	while (remaining > 0) {
+		const auto slice_start = now ();
+		if (slice_start >= end)
+			break;
+
+		// Jobs that finish early leave their unused share to the rest.
+		const auto share = (end - slice_start)
+						   / static_cast<int64_t> (remaining);
+		const auto deadline = slice_start + share;
+
+		Entry& entry = jobs[cursor];
+		entry.progress = std::clamp (
+			entry.slice (SliceBudget (deadline, now)), 0.0f, 1.0f
+		);
+		stats.slices++;
+
+		--remaining;
+		if (entry.progress >= 1.0f) {
+			jobs.erase (jobs.begin () + static_cast<ptrdiff_t> (cursor));
+			stats.completed++;
+			if (jobs.empty ())
+				break;
+			cursor %= jobs.size ();
+		} else {
+			cursor = (cursor + 1) % jobs.size ();
+		}
+	}
+
+	stats.last_used_ms = std::chrono::duration<float, std::milli> (
+							 now () - start
+	)
+							 .count ();
+	if (stats.last_used_ms > budget_ms)
+		stats.over_budget_frames++;
+}
+
+float IncrementalJobs::progress (const uint64_t id) const {
+	for (const Entry& entry : jobs)
+		if (entry.id == id)
+			return entry.progress;
+
+	std::lock_guard lock (incoming_mutex);
+	for (const Entry& entry : incoming)
+		if (entry.id == id)
+			return 0.0f;
+	return 1.0f;
+}
@@ -0,0 +1,86 @@
+#ifndef INCREMENTAL_H
+#define INCREMENTAL_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+// Source of the current time. Tests swap in a manual clock so budgets can be
+// checked without sleeping.
+using SliceClock = std::chrono::steady_clock::time_point (*) ();
+
+// Deadline handed to one slice. Slices check expired () between units of
+// work and return as soon as it is true.
+class SliceBudget {
+	using clock = std::chrono::steady_clock;
+
+  public:
+	explicit SliceBudget (
+		const clock::time_point deadline, const SliceClock now = clock::now
+	)
+		: deadline (deadline), now (now) {}
+
+	[[nodiscard]] bool expired () const { return now () >= deadline; }
+	[[nodiscard]] float remaining_ms () const {
+		return std::chrono::duration<float, std::milli> (deadline - now ())
+			.count ();
+	}
+
+  private:
+	clock::time_point deadline;
+	SliceClock now;
+};
+
+// A slice does some work and returns the job's progress in [0, 1]; 1 means
+// finished and the job is dropped.
+using IncrementalSlice = std::function<float (const SliceBudget&)>;
+
+struct IncrementalStats {
+	uint64_t slices = 0;
+	uint64_t completed = 0;
+	uint64_t over_budget_frames = 0;
+	float last_used_ms = 0.0f;
+};
+
+// Resumable jobs too big for one frame. run () gives each pending job a
+// fair share of the frame budget in turn, starting where the previous frame
+// stopped, so no job starves and the budget is never exceeded on purpose.
+// add () may be called from any thread; run () and progress () belong to
+// the frame thread.
+class IncrementalJobs {
+  public:
+	explicit IncrementalJobs (
+		const SliceClock now = std::chrono::steady_clock::now
+	)
+		: now (now) {}
+
+	uint64_t add (IncrementalSlice slice);
+	void run (float budget_ms);
+
+	// Finished and unknown jobs report 1, jobs not yet started report 0.
+	[[nodiscard]] float progress (uint64_t id) const;
+	[[nodiscard]] size_t size () const { return jobs.size (); }
+	[[nodiscard]] const IncrementalStats& get_stats () const { return stats; }
+
+  private:
+	struct Entry {
+		uint64_t id = 0;
+		IncrementalSlice slice;
+		float progress = 0.0f;
+	};
+
+	SliceClock now;
+
+	std::vector<Entry> jobs;
+	size_t cursor = 0;
+
+	std::vector<Entry> incoming;
+	mutable std::mutex incoming_mutex;
+	uint64_t next_id = 1;
+
+	IncrementalStats stats;
+};
+
+#endif // INCREMENTAL_H
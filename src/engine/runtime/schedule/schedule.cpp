@@ -1,15 +1,69 @@
 #include "schedule.h"
 
-#include "runtime/tasks/tasks.h"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
 
-Schedule::Schedule (float interval_ms, std::function<void (float)> task)
-	: interval (interval_ms), task (std::move (task)) {}
+Schedule::Schedule (SystemConfig config, std::function<void (float)> task)
+	: config (config), task (std::move (task)) {
+	assert (this->config.interval_ms > 0.0f);
+	assert (this->config.max_substeps > 0);
+}
 
-void Schedule::update (float delta_time_ms, TaskScheduler& scheduler) {
+int Schedule::advance (const float delta_time_ms) {
 	accumulated += delta_time_ms;
-	if (accumulated >= interval) {
-		float dt = accumulated;
-		scheduler.submit ([task = this->task, dt] () { task (dt); });
-		accumulated = 0.0f;
+
+	const int due = static_cast<int> (accumulated / config.interval_ms);
+	if (due == 0) {
+		pending_ticks = 0;
+		return 0;
 	}
+
+	accumulated -= static_cast<float> (due) * config.interval_ms;
+
+	int ticks = 1;
+	int consumed = 1;
+	tick_dt = config.interval_ms;
+
+	switch (config.catch_up) {
+	case CatchUp::Drop:
+		break;
+	case CatchUp::Clamp:
+		consumed = std::min (due, config.max_substeps);
+		tick_dt = config.interval_ms * static_cast<float> (consumed);
+		break;
+	case CatchUp::Substep:
+		ticks = consumed = std::min (due, config.max_substeps);
+		break;
+	}
+
+	stats.dropped_ticks += static_cast<uint64_t> (due - consumed);
+	pending_ticks = ticks;
+	return pending_ticks;
+}
+
+void Schedule::run () {
+	using clock = std::chrono::steady_clock;
+
+	for (int i = 0; i < pending_ticks; ++i) {
+		const auto start = clock::now ();
+		task (tick_dt);
+		stats.last_tick_ms = std::chrono::duration<float, std::milli> (
+								 clock::now () - start
+		)
+								 .count ();
+		stats.ticks++;
+
+		// A tick that blew its budget will not get cheaper on the next
+		// substep, so the rest of this frame's backlog is dropped.
+		if (config.budget_ms > 0.0f && stats.last_tick_ms > config.budget_ms) {
+			stats.over_budget_ticks++;
+			stats.dropped_ticks += static_cast<uint64_t> (
+				pending_ticks - i - 1
+			);
+			break;
+		}
+	}
+
+	pending_ticks = 0;
 }
@@ -1,19 +1,49 @@
 #ifndef SCHEDULE_H
 #define SCHEDULE_H
 
+#include <cstdint>
 #include <functional>
 
-class TaskScheduler;
+enum class CatchUp : uint8_t {
+	Drop,
+	Clamp,
+	Substep,
+};
+
+struct SystemConfig {
+	float interval_ms = 16.6667f;
+	CatchUp catch_up = CatchUp::Substep;
+	int max_substeps = 4;
+	float budget_ms = 0.0f;
+};
+
+struct ScheduleStats {
+	uint64_t ticks = 0;
+	uint64_t dropped_ticks = 0;
+	uint64_t over_budget_ticks = 0;
+	float last_tick_ms = 0.0f;
+};
 
 class Schedule {
   public:
-	Schedule (float interval_ms, std::function<void (float)> task);
-	void update (float delta_time_ms, TaskScheduler& scheduler);
+	Schedule (SystemConfig config, std::function<void (float)> task);
+
+	int advance (float delta_time_ms);
+	void run ();
+
+	[[nodiscard]] int get_pending_ticks () const { return pending_ticks; }
+	[[nodiscard]] float get_tick_dt () const { return tick_dt; }
+	[[nodiscard]] const ScheduleStats& get_stats () const { return stats; }
 
   private:
-	float interval;
-	float accumulated = 0.0f;
+	SystemConfig config;
 	std::function<void (float)> task;
+
+	float accumulated = 0.0f;
+	int pending_ticks = 0;
+	float tick_dt = 0.0f;
+
+	ScheduleStats stats;
 };
 
 #endif // SCHEDULE_H
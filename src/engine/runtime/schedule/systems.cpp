@@ -0,0 +1,30 @@
+#include "systems.h"
+
+#include "runtime/tasks/tasks.h"
+
+size_t SystemScheduler::add (
+	SystemConfig config, std::function<void (float)> task
+) {
+	schedules.emplace_back (config, std::move (task));
+	return schedules.size () - 1;
+}
+
+void SystemScheduler::update (
+	const float delta_time_ms, TaskScheduler& scheduler
+) {
+	// A system never overlaps its own previous step.
+	join (scheduler);
+
+	for (Schedule& schedule : schedules) {
+		if (schedule.advance (delta_time_ms) == 0)
+			continue;
+
+		Schedule* target = &schedule;
+		scheduler.submit ([target] () { target->run (); }, group);
+	}
+}
+
+void SystemScheduler::join (TaskScheduler& scheduler) {
+	if (!group.done ())
+		scheduler.wait (group);
+}
@@ -0,0 +1,32 @@
+#ifndef SYSTEMS_H
+#define SYSTEMS_H
+
+#include <deque>
+#include <functional>
+
+#include "runtime/tasks/job.h"
+#include "schedule.h"
+
+class TaskScheduler;
+
+// Runs every registered system at its own fixed rate. Due ticks are decided
+// on the calling thread, each system with work becomes one job, and join()
+// is the single point where their results become visible.
+class SystemScheduler {
+  public:
+	size_t add (SystemConfig config, std::function<void (float)> task);
+
+	void update (float delta_time_ms, TaskScheduler& scheduler);
+	void join (TaskScheduler& scheduler);
+
+	[[nodiscard]] const Schedule& get (size_t index) const {
+		return schedules[index];
+	}
+	[[nodiscard]] size_t size () const { return schedules.size (); }
+
+  private:
+	std::deque<Schedule> schedules;
+	TaskGroup group;
+};
+
+#endif // SYSTEMS_H
@@ -0,0 +1,75 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Linear allocator for job captures that do not fit inline. The scheduler
+// keeps one per frame parity and only rewinds an arena once every job that
+// borrowed from it has been destroyed.
+class JobArena {
+  public:
+	explicit JobArena (const size_t capacity)
+		: buffer (std::make_unique<std::byte[]> (capacity)),
+		  capacity (capacity) {}
+
+	JobArena (const JobArena&) = delete;
+	JobArena& operator= (const JobArena&) = delete;
+
+	void* allocate (const size_t size, const size_t alignment) {
+		assert ((alignment & (alignment - 1)) == 0);
+
+		outstanding.fetch_add (1);
+		if (!open.load ()) {
+			outstanding.fetch_sub (1);
+			return nullptr;
+		}
+
+		const auto base = reinterpret_cast<uintptr_t> (buffer.get ());
+		size_t current = offset.load (std::memory_order_relaxed);
+		size_t aligned;
+		do {
+			aligned = ((base + current + alignment - 1) & ~(alignment - 1))
+					  - base;
+			if (aligned + size > capacity) {
+				outstanding.fetch_sub (1);
+				return nullptr;
+			}
+		} while (!offset.compare_exchange_weak (
+			current, aligned + size, std::memory_order_relaxed
+		));
+
+		return buffer.get () + aligned;
+	}
+
+	void release () { outstanding.fetch_sub (1); }
+
+	void close () { open.store (false); }
+
+	bool try_reset () {
+		if (outstanding.load () != 0)
+			return false;
+
+		offset.store (0, std::memory_order_relaxed);
+		open.store (true);
+		return true;
+	}
+
+	[[nodiscard]] size_t used () const {
+		return offset.load (std::memory_order_relaxed);
+	}
+	[[nodiscard]] size_t size () const { return capacity; }
+
+  private:
+	std::unique_ptr<std::byte[]> buffer;
+	size_t capacity;
+
+	std::atomic<size_t> offset{0};
+	std::atomic<int64_t> outstanding{0};
+	std::atomic<bool> open{true};
+};
+
+#endif // ARENA_H
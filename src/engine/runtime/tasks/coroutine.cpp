@@ -0,0 +1,163 @@
+#include "coroutine.h"
+
+#include <mutex>
+#include <new>
+
+#include "tasks.h"
+
+namespace {
+constexpr std::array<size_t, 5> frame_sizes{256, 512, 1024, 2048, 4096};
+constexpr size_t oversized_frame = frame_sizes.size ();
+
+struct FreeFrame {
+	FreeFrame* next;
+};
+
+struct FrameClass {
+	std::mutex mutex;
+	FreeFrame* free = nullptr;
+
+	~FrameClass () {
+		while (free)
+			::operator delete (std::exchange (free, free->next));
+	}
+};
+
+std::array<FrameClass, frame_sizes.size ()> frame_classes;
+std::atomic<uint64_t> frames_allocated{0};
+std::atomic<uint64_t> frames_reused{0};
+std::atomic<uint64_t> frames_oversized{0};
+
+size_t frame_class_for (const size_t size) {
+	for (size_t i = 0; i < frame_sizes.size (); ++i)
+		if (size <= frame_sizes[i])
+			return i;
+	return oversized_frame;
+}
+} // namespace
+
+void* allocate_coroutine_frame (const size_t size) {
+	const size_t index = frame_class_for (size);
+	if (index == oversized_frame) {
+		frames_oversized.fetch_add (1, std::memory_order_relaxed);
+		return ::operator new (size);
+	}
+
+	FrameClass& frame_class = frame_classes[index];
+	{
+		std::lock_guard lock (frame_class.mutex);
+		if (FreeFrame* frame = frame_class.free) {
+			frame_class.free = frame->next;
+			frames_reused.fetch_add (1, std::memory_order_relaxed);
+			return frame;
+		}
+	}
+
+	frames_allocated.fetch_add (1, std::memory_order_relaxed);
+	return ::operator new (frame_sizes[index]);
+}
+
+void release_coroutine_frame (void* frame, const size_t size) {
+	const size_t index = frame_class_for (size);
+	if (index == oversized_frame) {
+		::operator delete (frame);
+		return;
+	}
+
+	FrameClass& frame_class = frame_classes[index];
+	std::lock_guard lock (frame_class.mutex);
+	frame_class.free = new (frame) FreeFrame{frame_class.free};
+}
+
+CoroutineFrameStats get_coroutine_frame_stats () {
+	CoroutineFrameStats out{};
+	out.allocated = frames_allocated.load (std::memory_order_relaxed);
+	out.reused = frames_reused.load (std::memory_order_relaxed);
+	out.oversized = frames_oversized.load (std::memory_order_relaxed);
+	return out;
+}
+
+std::coroutine_handle<> Coroutine::FinalAwaiter::await_suspend (
+	const Handle handle
+) noexcept {
+	promise_type& promise = handle.promise ();
+	const State previous = promise.state.exchange (State::Finished);
+
+	if (previous == State::Awaited)
+		return promise.continuation;
+	if (previous == State::Detached)
+		handle.destroy ();
+	return std::noop_coroutine ();
+}
+
+bool Coroutine::Awaiter::await_ready () const noexcept {
+	return !handle || handle.promise ().state.load () == State::Finished;
+}
+
+bool Coroutine::Awaiter::await_suspend (
+	const std::coroutine_handle<> awaiting
+) const noexcept {
+	promise_type& promise = handle.promise ();
+	promise.continuation = awaiting;
+
+	State expected = State::Running;
+	return promise.state.compare_exchange_strong (expected, State::Awaited);
+}
+
+Coroutine& Coroutine::operator= (Coroutine&& other) noexcept {
+	if (this != &other) {
+		release ();
+		handle = std::exchange (other.handle, {});
+	}
+	return *this;
+}
+
+Coroutine::~Coroutine () { release (); }
+
+bool Coroutine::done () const {
+	return !handle || handle.promise ().state.load () == State::Finished;
+}
+
+void Coroutine::release () {
+	if (!handle)
+		return;
+
+	if (handle.promise ().state.exchange (State::Detached) == State::Finished)
+		handle.destroy ();
+	handle = {};
+}
+
+void resume_on (TaskScheduler& scheduler, std::coroutine_handle<> handle) {
+	scheduler.submit ([handle] () { handle.resume (); });
+}
+
+void ScheduleAwaiter::await_suspend (
+	const std::coroutine_handle<> awaiting
+) const {
+	resume_on (scheduler, awaiting);
+}
+
+FrameAwaiter::FrameAwaiter (TaskScheduler& scheduler) {
+	this->scheduler = &scheduler;
+	notify = [] (JobWaiter& waiter) {
+		auto& self = static_cast<FrameAwaiter&> (waiter);
+		resume_on (*self.scheduler, self.continuation);
+	};
+}
+
+void FrameAwaiter::await_suspend (const std::coroutine_handle<> awaiting) {
+	continuation = awaiting;
+	scheduler->defer_to_next_frame (*this);
+}
+
+JobAwaiter::JobAwaiter (JobHandle handle) : handle (std::move (handle)) {
+	notify = [] (JobWaiter& waiter) {
+		auto& self = static_cast<JobAwaiter&> (waiter);
+		resume_on (*self.scheduler, self.continuation);
+	};
+}
+
+bool JobAwaiter::await_suspend (const std::coroutine_handle<> awaiting) {
+	continuation = awaiting;
+	return handle.add_waiter (*this);
+}
@@ -0,0 +1,178 @@
+#ifndef COROUTINE_H
+#define COROUTINE_H
+
+#include <array>
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <utility>
+
+#include "job.h"
+
+class TaskScheduler;
+
+struct CoroutineFrameStats {
+	uint64_t allocated = 0;
+	uint64_t reused = 0;
+	uint64_t oversized = 0;
+};
+
+void* allocate_coroutine_frame (size_t size);
+void release_coroutine_frame (void* frame, size_t size);
+CoroutineFrameStats get_coroutine_frame_stats ();
+
+// Eagerly started coroutine. Frames come from a size-classed pool so
+// steady-state coroutines do not touch the heap. Dropping the Coroutine
+// before it finishes detaches it; the frame then frees itself.
+class Coroutine {
+  public:
+	struct promise_type;
+	using Handle = std::coroutine_handle<promise_type>;
+
+	enum class State : uint8_t { Running, Awaited, Finished, Detached };
+
+	struct FinalAwaiter {
+		[[nodiscard]] bool await_ready () const noexcept { return false; }
+		std::coroutine_handle<> await_suspend (Handle handle) noexcept;
+		void await_resume () const noexcept {}
+	};
+
+	struct promise_type {
+		Coroutine get_return_object () {
+			return Coroutine (Handle::from_promise (*this));
+		}
+		std::suspend_never initial_suspend () const noexcept { return {}; }
+		FinalAwaiter final_suspend () const noexcept { return {}; }
+		void return_void () const {}
+		void unhandled_exception () const { std::terminate (); }
+
+		static void* operator new (const size_t size) {
+			return allocate_coroutine_frame (size);
+		}
+		static void operator delete (void* frame, const size_t size) {
+			release_coroutine_frame (frame, size);
+		}
+
+		std::atomic<State> state{State::Running};
+		std::coroutine_handle<> continuation;
+	};
+
+	struct Awaiter {
+		[[nodiscard]] bool await_ready () const noexcept;
+		bool await_suspend (std::coroutine_handle<> awaiting) const noexcept;
+		void await_resume () const noexcept {}
+
+		Handle handle;
+	};
+
+	Coroutine () = default;
+	Coroutine (Coroutine&& other) noexcept
+		: handle (std::exchange (other.handle, {})) {}
+	Coroutine& operator= (Coroutine&& other) noexcept;
+	~Coroutine ();
+
+	Coroutine (const Coroutine&) = delete;
+	Coroutine& operator= (const Coroutine&) = delete;
+
+	[[nodiscard]] bool done () const;
+	Awaiter operator co_await () const noexcept { return {handle}; }
+
+  private:
+	explicit Coroutine (const Handle handle) : handle (handle) {}
+
+	void release ();
+
+	Handle handle;
+};
+
+struct ScheduleAwaiter {
+	[[nodiscard]] bool await_ready () const noexcept { return false; }
+	void await_suspend (std::coroutine_handle<> awaiting) const;
+	void await_resume () const noexcept {}
+
+	TaskScheduler& scheduler;
+};
+
+struct FrameAwaiter : JobWaiter {
+	explicit FrameAwaiter (TaskScheduler& scheduler);
+
+	[[nodiscard]] bool await_ready () const noexcept { return false; }
+	void await_suspend (std::coroutine_handle<> awaiting);
+	void await_resume () const noexcept {}
+
+	std::coroutine_handle<> continuation;
+};
+
+struct JobAwaiter : JobWaiter {
+	explicit JobAwaiter (JobHandle handle);
+
+	[[nodiscard]] bool await_ready () const noexcept { return handle.done (); }
+	bool await_suspend (std::coroutine_handle<> awaiting);
+	void await_resume () const noexcept {}
+
+	JobHandle handle;
+	std::coroutine_handle<> continuation;
+};
+
+inline JobAwaiter operator co_await (JobHandle handle) {
+	return JobAwaiter (std::move (handle));
+}
+
+void resume_on (TaskScheduler& scheduler, std::coroutine_handle<> handle);
+
+template <size_t Count> class WhenAll {
+  public:
+	explicit WhenAll (std::array<JobHandle, Count> handles)
+		: handles (std::move (handles)) {}
+
+	[[nodiscard]] bool await_ready () const noexcept {
+		for (const JobHandle& handle : handles)
+			if (!handle.done ())
+				return false;
+		return true;
+	}
+
+	bool await_suspend (std::coroutine_handle<> awaiting) {
+		continuation = awaiting;
+		remaining.store (Count + 1);
+
+		for (size_t i = 0; i < Count; ++i) {
+			links[i].owner = this;
+			links[i].notify = &Link::arrive;
+			if (!handles[i].add_waiter (links[i]))
+				remaining.fetch_sub (1);
+		}
+
+		// The extra count keeps the coroutine from being resumed while
+		// links are still being registered.
+		return remaining.fetch_sub (1) != 1;
+	}
+
+	void await_resume () const noexcept {}
+
+  private:
+	struct Link : JobWaiter {
+		WhenAll* owner = nullptr;
+
+		static void arrive (JobWaiter& waiter) {
+			auto& link = static_cast<Link&> (waiter);
+			WhenAll& self = *link.owner;
+			if (self.remaining.fetch_sub (1) == 1)
+				resume_on (*link.scheduler, self.continuation);
+		}
+	};
+
+	std::array<JobHandle, Count> handles;
+	std::array<Link, Count> links{};
+	std::atomic<size_t> remaining{0};
+	std::coroutine_handle<> continuation;
+};
+
+template <class... Handles> auto when_all (Handles... handles) {
+	return WhenAll<sizeof...(Handles)> (
+		std::array<JobHandle, sizeof...(Handles)>{std::move (handles)...}
+	);
+}
+
+#endif // COROUTINE_H
@@ -0,0 +1,130 @@
+#ifndef DEQUE_H
+#define DEQUE_H
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+enum class StealResult : uint8_t { Empty, Success, Contended };
+
+// Chase-Lev work-stealing deque. The owning thread pushes and pops at the
+// bottom, any other thread steals from the top.
+template <class T> class WorkStealingDeque {
+	static_assert (std::is_trivially_copyable_v<T>);
+
+  public:
+	explicit WorkStealingDeque (const int64_t initial_capacity = 1024) {
+		assert (initial_capacity > 0);
+		assert ((initial_capacity & (initial_capacity - 1)) == 0);
+		rings.emplace_back (std::make_unique<Ring> (initial_capacity));
+		ring.store (rings.back ().get (), std::memory_order_relaxed);
+	}
+
+	WorkStealingDeque (const WorkStealingDeque&) = delete;
+	WorkStealingDeque& operator= (const WorkStealingDeque&) = delete;
+
+	void push (T item) {
+		const int64_t b = bottom.load (std::memory_order_relaxed);
+		const int64_t t = top.load (std::memory_order_acquire);
+		Ring* current = ring.load (std::memory_order_relaxed);
+
+		if (b - t > current->capacity - 1)
+			current = grow (current, b, t);
+
+		current->store (b, item);
+		bottom.store (b + 1, std::memory_order_release);
+	}
+
+	bool pop (T& out) {
+		const int64_t b = bottom.load (std::memory_order_relaxed) - 1;
+		Ring* current = ring.load (std::memory_order_relaxed);
+		bottom.store (b, std::memory_order_relaxed);
+		std::atomic_thread_fence (std::memory_order_seq_cst);
+		int64_t t = top.load (std::memory_order_relaxed);
+
+		if (t > b) {
+			bottom.store (b + 1, std::memory_order_relaxed);
+			return false;
+		}
+
+		out = current->load (b);
+		if (t != b)
+			return true;
+
+		// Last item, race any thief for it.
+		const bool won = top.compare_exchange_strong (
+			t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed
+		);
+		bottom.store (b + 1, std::memory_order_relaxed);
+		return won;
+	}
+
+	StealResult steal (T& out) {
+		int64_t t = top.load (std::memory_order_acquire);
+		std::atomic_thread_fence (std::memory_order_seq_cst);
+		const int64_t b = bottom.load (std::memory_order_acquire);
+
+		if (t >= b)
+			return StealResult::Empty;
+
+		const Ring* current = ring.load (std::memory_order_acquire);
+		T item = current->load (t);
+		if (!top.compare_exchange_strong (
+				t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed
+			))
+			return StealResult::Contended;
+
+		out = item;
+		return StealResult::Success;
+	}
+
+	[[nodiscard]] int64_t size_approx () const {
+		const int64_t b = bottom.load (std::memory_order_relaxed);
+		const int64_t t = top.load (std::memory_order_relaxed);
+		return b > t ? b - t : 0;
+	}
+
+	[[nodiscard]] bool empty () const { return size_approx () == 0; }
+
+  private:
+	struct Ring {
+		explicit Ring (const int64_t capacity)
+			: capacity (capacity), mask (capacity - 1),
+			  slots (std::make_unique<std::atomic<T>[]> (capacity)) {}
+
+		[[nodiscard]] T load (const int64_t index) const {
+			return slots[index & mask].load (std::memory_order_relaxed);
+		}
+
+		void store (const int64_t index, T item) {
+			slots[index & mask].store (item, std::memory_order_relaxed);
+		}
+
+		int64_t capacity;
+		int64_t mask;
+		std::unique_ptr<std::atomic<T>[]> slots;
+	};
+
+	Ring* grow (const Ring* current, const int64_t b, const int64_t t) {
+		auto bigger = std::make_unique<Ring> (current->capacity * 2);
+		for (int64_t i = t; i < b; ++i)
+			bigger->store (i, current->load (i));
+
+		// Thieves may still be reading the old ring, so it is only retired.
+		Ring* raw = bigger.get ();
+		rings.emplace_back (std::move (bigger));
+		ring.store (raw, std::memory_order_release);
+		return raw;
+	}
+
+	alignas (64) std::atomic<int64_t> top{0};
+	alignas (64) std::atomic<int64_t> bottom{0};
+	alignas (64) std::atomic<Ring*> ring{nullptr};
+
+	std::vector<std::unique_ptr<Ring>> rings;
+};
+
+#endif // DEQUE_H
@@ -0,0 +1,26 @@
+#include "job.h"
+
+#include <cassert>
+
+#include "tasks.h"
+
+JobHandle JobHandle::then (Job continuation) const {
+	assert (node);
+	return node->scheduler->schedule (
+		std::move (continuation), {*this}, node->group
+	);
+}
+
+bool JobHandle::add_waiter (JobWaiter& waiter) const {
+	if (!node)
+		return false;
+
+	std::lock_guard lock (node->continuation_mutex);
+	if (node->finished.load (std::memory_order_acquire))
+		return false;
+
+	waiter.scheduler = node->scheduler;
+	waiter.next = node->waiters;
+	node->waiters = &waiter;
+	return true;
+}
@@ -0,0 +1,246 @@
+#ifndef JOB_H
+#define JOB_H
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "arena.h"
+
+class TaskScheduler;
+
+enum class JobStorage : uint8_t { Empty, Inline, Arena, Heap };
+
+// Move-only callable with a fixed inline buffer. Captures that do not fit go
+// to the supplied arena, or to the heap when there is none.
+class Job {
+  public:
+	static constexpr size_t inline_size = 64;
+
+	Job () = default;
+
+	template <class Function>
+		requires (!std::is_same_v<std::decay_t<Function>, Job>
+				  && std::is_invocable_v<std::decay_t<Function>&>)
+	Job (Function&& function, JobArena* arena = nullptr);
+
+	Job (Job&& other) noexcept { take (other); }
+	Job& operator= (Job&& other) noexcept {
+		if (this != &other) {
+			reset ();
+			take (other);
+		}
+		return *this;
+	}
+
+	Job (const Job&) = delete;
+	Job& operator= (const Job&) = delete;
+
+	~Job () { reset (); }
+
+	explicit operator bool () const { return invoke != nullptr; }
+	// An empty or moved-from job does nothing when invoked.
+	void operator() () {
+		if (invoke)
+			invoke (buffer);
+	}
+
+	void reset () {
+		if (manage)
+			manage (Operation::Destroy, buffer, nullptr);
+		invoke = nullptr;
+		manage = nullptr;
+		storage = JobStorage::Empty;
+	}
+
+	[[nodiscard]] JobStorage get_storage () const { return storage; }
+
+  private:
+	enum class Operation : uint8_t { Move, Destroy };
+
+	struct External {
+		void* object;
+		JobArena* arena;
+	};
+
+	using Invoke = void (*) (void* data);
+	using Manage = void (*) (Operation operation, void* data, void* from);
+
+	void take (Job& other) {
+		if (other.manage)
+			other.manage (Operation::Move, buffer, other.buffer);
+		invoke = std::exchange (other.invoke, nullptr);
+		manage = std::exchange (other.manage, nullptr);
+		storage = std::exchange (other.storage, JobStorage::Empty);
+	}
+
+	alignas (std::max_align_t) std::byte buffer[inline_size];
+	Invoke invoke = nullptr;
+	Manage manage = nullptr;
+	JobStorage storage = JobStorage::Empty;
+};
+
+class TaskGroup {
+  public:
+	TaskGroup () = default;
+	TaskGroup (const TaskGroup&) = delete;
+	TaskGroup& operator= (const TaskGroup&) = delete;
+
+	[[nodiscard]] bool done () const { return pending_count () == 0; }
+	[[nodiscard]] int pending_count () const {
+		return static_cast<int> (state.load () & count_mask);
+	}
+
+	// Jobs that have not started yet are dropped and new submissions are
+	// refused. Running jobs may poll cancelled () and return early.
+	void cancel () { state.fetch_or (cancelled_bit); }
+	[[nodiscard]] bool cancelled () const {
+		return (state.load () & cancelled_bit) != 0;
+	}
+
+	// Re-arms a drained group after cancel (). Nothing may be submitted to
+	// the group concurrently.
+	void reset () {
+		uint32_t expected = state.load ();
+		assert ((expected & count_mask) == 0);
+		const bool rearmed = state.compare_exchange_strong (expected, 0);
+		assert (rearmed);
+		(void)rearmed;
+	}
+
+  private:
+	friend class TaskScheduler;
+
+	static constexpr uint32_t cancelled_bit = 1u << 31;
+	static constexpr uint32_t count_mask = cancelled_bit - 1;
+
+	// Counting and the cancel check are one transition, so a submit racing
+	// cancel () either lands before it, and is waited for, or is refused.
+	bool try_add () {
+		uint32_t current = state.load ();
+		do {
+			if (current & cancelled_bit)
+				return false;
+		} while (!state.compare_exchange_weak (current, current + 1));
+		return true;
+	}
+
+	void finish () { state.fetch_sub (1); }
+
+	std::atomic<uint32_t> state{0};
+};
+
+// Intrusive wait-list entry used by coroutine awaiters. The entry lives in
+// the awaiting coroutine frame, so registering it never allocates.
+struct JobWaiter {
+	TaskScheduler* scheduler = nullptr;
+	JobWaiter* next = nullptr;
+	void (*notify) (JobWaiter& waiter) = nullptr;
+};
+
+struct JobNode {
+	TaskScheduler* scheduler = nullptr;
+	TaskGroup* group = nullptr;
+	Job work;
+
+	std::atomic<int> unresolved{0};
+	std::atomic<bool> finished{false};
+
+	std::mutex continuation_mutex;
+	std::vector<std::shared_ptr<JobNode>> continuations;
+	JobWaiter* waiters = nullptr;
+};
+
+class JobHandle {
+  public:
+	JobHandle () = default;
+
+	[[nodiscard]] bool valid () const { return node != nullptr; }
+	[[nodiscard]] bool done () const {
+		return !node || node->finished.load (std::memory_order_acquire);
+	}
+
+	JobHandle then (Job continuation) const;
+
+	// Returns false when the job has already finished.
+	bool add_waiter (JobWaiter& waiter) const;
+
+  private:
+	friend class TaskScheduler;
+
+	explicit JobHandle (std::shared_ptr<JobNode> node)
+		: node (std::move (node)) {}
+
+	std::shared_ptr<JobNode> node;
+};
+
+template <class Function>
+	requires (!std::is_same_v<std::decay_t<Function>, Job>
+			  && std::is_invocable_v<std::decay_t<Function>&>)
+Job::Job (Function&& function, JobArena* arena) {
+	using Callable = std::decay_t<Function>;
+
+	constexpr bool fits = sizeof (Callable) <= inline_size
+						  && alignof (Callable) <= alignof (std::max_align_t)
+						  && std::is_nothrow_move_constructible_v<Callable>;
+
+	if constexpr (fits) {
+		new (buffer) Callable (std::forward<Function> (function));
+		storage = JobStorage::Inline;
+
+		invoke = [] (void* data) { (*static_cast<Callable*> (data)) (); };
+		manage = [] (const Operation operation, void* data, void* from) {
+			auto* source = static_cast<Callable*> (from);
+			if (operation == Operation::Move) {
+				new (data) Callable (std::move (*source));
+				source->~Callable ();
+			} else {
+				static_cast<Callable*> (data)->~Callable ();
+			}
+		};
+	} else {
+		void* memory = nullptr;
+		if (arena)
+			memory = arena->allocate (sizeof (Callable), alignof (Callable));
+
+		External external{nullptr, memory ? arena : nullptr};
+		if (memory) {
+			external.object = new (memory)
+				Callable (std::forward<Function> (function));
+			storage = JobStorage::Arena;
+		} else {
+			external.object = new Callable (std::forward<Function> (function));
+			storage = JobStorage::Heap;
+		}
+		new (buffer) External (external);
+
+		invoke = [] (void* data) {
+			const External& external = *static_cast<External*> (data);
+			(*static_cast<Callable*> (external.object)) ();
+		};
+		manage = [] (const Operation operation, void* data, void* from) {
+			if (operation == Operation::Move) {
+				new (data) External (*static_cast<External*> (from));
+				return;
+			}
+
+			const External& external = *static_cast<External*> (data);
+			auto* object = static_cast<Callable*> (external.object);
+			if (external.arena) {
+				object->~Callable ();
+				external.arena->release ();
+			} else {
+				delete object;
+			}
+		};
+	}
+}
+
+#endif // JOB_H
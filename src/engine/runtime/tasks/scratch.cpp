@@ -0,0 +1,105 @@
+#include "scratch.h"
+
+#include <algorithm>
+#include <cassert>
+#include <memory>
+#include <new>
+
+namespace {
+thread_local ScratchArena* bound_arena = nullptr;
+thread_local std::unique_ptr<ScratchArena> local_arena;
+
+constexpr size_t reserved_fallbacks = 32;
+} // namespace
+
+ScratchArena::ScratchArena (const size_t capacity)
+	: buffer (static_cast<std::byte*> (
+		  ::operator new (capacity, std::align_val_t{max_alignment})
+	  )),
+	  capacity (capacity) {
+	fallbacks.reserve (reserved_fallbacks);
+}
+
+ScratchArena::~ScratchArena () {
+	rewind ({});
+	::operator delete (buffer, std::align_val_t{max_alignment});
+}
+
+ScratchMarker ScratchArena::mark () const {
+	return {offset, fallbacks.size ()};
+}
+
+void ScratchArena::rewind (const ScratchMarker marker) {
+	// Popping a block from before the mark can leave offset below it.
+	offset = std::min (offset, marker.offset);
+	while (fallbacks.size () > marker.fallbacks)
+		release_fallback (fallbacks.size () - 1);
+}
+
+ScratchStats ScratchArena::get_stats () const {
+	ScratchStats out{};
+	out.fallbacks = fallback_count.load (std::memory_order_relaxed);
+	out.high_water = high_water.load (std::memory_order_relaxed);
+	out.capacity = capacity;
+	return out;
+}
+
+void* ScratchArena::do_allocate (const size_t bytes, const size_t alignment) {
+	assert (alignment <= max_alignment);
+
+	const size_t aligned = (offset + alignment - 1) & ~(alignment - 1);
+	if (aligned + bytes <= capacity) {
+		offset = aligned + bytes;
+		note_usage ();
+		return buffer + aligned;
+	}
+
+	void* memory = ::operator new (bytes, std::align_val_t{alignment});
+	fallbacks.push_back ({memory, bytes, alignment});
+	fallback_bytes += bytes;
+	fallback_count.fetch_add (1, std::memory_order_relaxed);
+	note_usage ();
+	return memory;
+}
+
+void ScratchArena::do_deallocate (
+	void* memory, const size_t bytes, const size_t
+) {
+	auto* block = static_cast<std::byte*> (memory);
+	if (block >= buffer && block < buffer + capacity) {
+		if (block + bytes == buffer + offset)
+			offset = static_cast<size_t> (block - buffer);
+		return;
+	}
+
+	for (size_t i = fallbacks.size (); i-- > 0;)
+		if (fallbacks[i].memory == memory) {
+			release_fallback (i);
+			return;
+		}
+}
+
+void ScratchArena::release_fallback (const size_t index) {
+	const Fallback fallback = fallbacks[index];
+	::operator delete (
+		fallback.memory, std::align_val_t{fallback.alignment}
+	);
+	fallback_bytes -= fallback.bytes;
+	fallbacks.erase (fallbacks.begin () + static_cast<ptrdiff_t> (index));
+}
+
+void ScratchArena::note_usage () {
+	const size_t in_use = used ();
+	if (in_use > high_water.load (std::memory_order_relaxed))
+		high_water.store (in_use, std::memory_order_relaxed);
+}
+
+ScratchArena& scratch_arena () {
+	if (bound_arena)
+		return *bound_arena;
+	if (!local_arena)
+		local_arena = std::make_unique<ScratchArena> (default_scratch_bytes);
+	return *local_arena;
+}
+
+void bind_scratch_arena (ScratchArena* arena) { bound_arena = arena; }
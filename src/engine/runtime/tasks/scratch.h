@@ -0,0 +1,98 @@
+#ifndef SCRATCH_H
+#define SCRATCH_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+struct ScratchStats {
+	uint64_t fallbacks = 0;
+	size_t high_water = 0;
+	size_t capacity = 0;
+};
+
+struct ScratchMarker {
+	size_t offset = 0;
+	size_t fallbacks = 0;
+};
+
+// Stack allocator for temporaries inside a job. mark () and rewind () free
+// everything allocated in between at once; freeing the most recent block
+// also pops it. Requests that do not fit go to the heap and are counted, and
+// the high-water mark covers both, so it is the capacity that would have
+// avoided every fallback. Owned by one thread; only get_stats () may be
+// called from others.
+class ScratchArena final : public std::pmr::memory_resource {
+  public:
+	explicit ScratchArena (size_t capacity);
+	~ScratchArena () override;
+
+	ScratchArena (const ScratchArena&) = delete;
+	ScratchArena& operator= (const ScratchArena&) = delete;
+
+	[[nodiscard]] ScratchMarker mark () const;
+	void rewind (ScratchMarker marker);
+
+	[[nodiscard]] size_t used () const { return offset + fallback_bytes; }
+	[[nodiscard]] ScratchStats get_stats () const;
+
+	static constexpr size_t max_alignment = 64;
+
+  private:
+	struct Fallback {
+		void* memory;
+		size_t bytes;
+		size_t alignment;
+	};
+
+	void* do_allocate (size_t bytes, size_t alignment) override;
+	void do_deallocate (void* memory, size_t bytes, size_t alignment) override;
+	[[nodiscard]] bool
+	do_is_equal (const memory_resource& other) const noexcept override {
+		return this == &other;
+	}
+
+	void release_fallback (size_t index);
+	void note_usage ();
+
+	std::byte* buffer;
+	size_t capacity;
+	size_t offset = 0;
+
+	std::vector<Fallback> fallbacks;
+	size_t fallback_bytes = 0;
+
+	std::atomic<uint64_t> fallback_count{0};
+	std::atomic<size_t> high_water{0};
+};
+
+// The calling thread's scratch arena: the worker's own on scheduler
+// workers, a lazily created one of default_scratch_bytes elsewhere.
+ScratchArena& scratch_arena ();
+void bind_scratch_arena (ScratchArena* arena);
+
+inline constexpr size_t default_scratch_bytes = 64 * 1024;
+
+// Rewinds this thread's arena on scope exit. Containers built on resource ()
+// must not outlive the scope, and a coroutine must not keep one open across
+// a suspension, since it may resume on another worker.
+class ScratchScope {
+  public:
+	ScratchScope () : arena (scratch_arena ()), marker (arena.mark ()) {}
+	~ScratchScope () { arena.rewind (marker); }
+
+	ScratchScope (const ScratchScope&) = delete;
+	ScratchScope& operator= (const ScratchScope&) = delete;
+
+	[[nodiscard]] std::pmr::memory_resource* resource () const {
+		return &arena;
+	}
+
+  private:
+	ScratchArena& arena;
+	ScratchMarker marker;
+};
+
+#endif // SCRATCH_H
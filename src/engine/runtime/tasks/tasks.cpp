@@ -1,22 +1,183 @@
 #include "tasks.h"
 
+#include <algorithm>
+#include <cassert>
+#include <chrono>
 #include <iostream>
+#include <new>
+#include <string>
+
+namespace {
+thread_local const TaskScheduler* current_scheduler = nullptr;
+thread_local size_t current_worker_index = 0;
+thread_local uint64_t helper_random_state = 0x9e3779b97f4a7c15ULL;
+
+constexpr int spin_rounds = 64;
+
+constexpr uint64_t free_index_mask = 0xffffffffULL;
+constexpr uint64_t free_tag_step = 1ULL << 32;
+
+uint64_t next_random (uint64_t& state) {
+	state ^= state << 13;
+	state ^= state >> 7;
+	state ^= state << 17;
+	return state;
+}
+
+uint64_t now_ns () {
+	return static_cast<uint64_t> (
+		std::chrono::duration_cast<std::chrono::nanoseconds> (
+			std::chrono::steady_clock::now ().time_since_epoch ()
+		)
+			.count ()
+	);
+}
+
+TaskSchedulerConfig latency_only (const size_t threads) {
+	TaskSchedulerConfig config;
+	config.latency_threads = threads;
+	return config;
+}
+
+struct ParallelRange {
+	size_t begin = 0;
+	size_t end = 0;
+	size_t chunk_size = 0;
+	size_t chunk_count = 0;
+
+	void (*body) (void*, size_t, size_t, size_t) = nullptr;
+	void* context = nullptr;
+
+	std::atomic<size_t> next_chunk{0};
+	std::atomic<size_t> completed_chunks{0};
+
+	// Shared by the caller and its helpers; the last one out frees it.
+	JobArena* arena = nullptr;
+	std::atomic<size_t> references{0};
+
+	static ParallelRange* create (JobArena* arena) {
+		void* storage = arena->allocate (
+			sizeof (ParallelRange), alignof (ParallelRange)
+		);
+		if (!storage)
+			return new ParallelRange ();
+
+		auto* range = new (storage) ParallelRange ();
+		range->arena = arena;
+		return range;
+	}
+
+	void release () {
+		if (references.fetch_sub (1) != 1)
+			return;
+
+		JobArena* owner = arena;
+		if (!owner) {
+			delete this;
+			return;
+		}
+		this->~ParallelRange ();
+		owner->release ();
+	}
+
+	void run () {
+		while (true) {
+			const size_t chunk = next_chunk.fetch_add (1);
+			if (chunk >= chunk_count)
+				return;
+
+			const size_t chunk_begin = begin + chunk * chunk_size;
+			const size_t chunk_end = std::min (end, chunk_begin + chunk_size);
+			body (context, chunk, chunk_begin, chunk_end);
+
+			if (completed_chunks.fetch_add (1) + 1 == chunk_count)
+				completed_chunks.notify_all ();
+		}
+	}
+
+	void wait () {
+		size_t completed;
+		while ((completed = completed_chunks.load ()) != chunk_count)
+			completed_chunks.wait (completed);
+	}
+};
+} // namespace
 
 TaskScheduler::TaskScheduler (const size_t num_threads)
-	: thread_count (num_threads) {}
+	: TaskScheduler (latency_only (num_threads)) {}
+
+TaskScheduler::TaskScheduler (TaskSchedulerConfig config)
+	: thread_count (config.latency_threads + config.background_threads),
+	  config (std::move (config)),
+	  task_pool (std::make_unique<Task[]> (task_pool_capacity)) {
+	assert (this->config.latency_threads > 0);
+
+	Lane& latency = lanes[static_cast<size_t> (WorkerClass::Latency)];
+	latency.worker_count = this->config.latency_threads;
 
-TaskScheduler::~TaskScheduler () { stop (); }
+	Lane& background = lanes[static_cast<size_t> (WorkerClass::Background)];
+	background.first_worker = latency.worker_count;
+	background.worker_count = this->config.background_threads;
+
+	for (uint32_t i = 0; i < task_pool_capacity; ++i) {
+		task_pool[i].pool_index = i + 1;
+		task_pool[i].next_free.store (
+			i + 1 < task_pool_capacity ? i + 2 : 0, std::memory_order_relaxed
+		);
+	}
+	free_tasks.store (1);
+}
+
+TaskScheduler::~TaskScheduler () {
+	stop ();
+
+	for (Lane& lane : lanes)
+		while (Task* task = pop_injected (lane))
+			release_task (task);
+}
 
 void TaskScheduler::start () {
 	if (running)
 		return;
 
 	running = true;
+
+	workers.clear ();
 	workers.reserve (thread_count);
 	for (size_t i = 0; i < thread_count; ++i) {
-		workers.emplace_back ([this] () {
-			pthread_set_qos_class_self_np (QOS_CLASS_USER_INTERACTIVE, 0);
-			this->do_work ();
+		const WorkerClass worker_class = i < config.latency_threads
+											 ? WorkerClass::Latency
+											 : WorkerClass::Background;
+
+		workers.emplace_back (
+			std::make_unique<Worker> (config.scratch_bytes)
+		);
+		workers.back ()->random_state = 0x9e3779b97f4a7c15ULL * (i + 1);
+		workers.back ()->worker_class = worker_class;
+		workers.back ()->lane = &lanes[static_cast<size_t> (worker_class)];
+	}
+
+	for (size_t i = 0; i < thread_count; ++i) {
+		workers[i]->thread = std::thread ([this, i] () {
+			const Worker& worker = *workers[i];
+			const bool latency = worker.worker_class == WorkerClass::Latency;
+			const size_t class_index = i - worker.lane->first_worker;
+
+			const std::string name = config.name
+									 + (latency ? "-" : "-bg-")
+									 + std::to_string (class_index);
+			const std::vector<size_t> none;
+			const std::vector<size_t>& cpus = i < config.affinity.size ()
+												  ? config.affinity[i]
+												  : none;
+
+			if (!configure_current_thread (
+					name, worker.worker_class,
+					latency ? config.latency : config.background, cpus
+				))
+				thread_config_failures.fetch_add (1);
+
+			this->do_work (i);
 		});
 	}
 }
@@ -26,54 +187,612 @@ void TaskScheduler::stop () {
 		return;
 
 	running = false;
-	condition_variable.notify_all ();
+	for (Lane& lane : lanes) {
+		std::lock_guard lock (lane.sleep_mutex);
+		lane.condition_variable.notify_all ();
+	}
 
-	for (auto& t : workers)
-		if (t.joinable ())
-			t.join ();
+	for (const auto& worker : workers)
+		if (worker->thread.joinable ())
+			worker->thread.join ();
+}
 
-	workers.clear ();
+TaskScheduler::Task* TaskScheduler::acquire_task () {
+	uint64_t head = free_tasks.load (std::memory_order_acquire);
+	while (true) {
+		const auto index = static_cast<uint32_t> (head & free_index_mask);
+		if (index == 0) {
+			task_pool_misses.fetch_add (1, std::memory_order_relaxed);
+			return new Task ();
+		}
+
+		Task& task = task_pool[index - 1];
+		const uint64_t next = ((head & ~free_index_mask) + free_tag_step)
+							  | task.next_free.load (std::memory_order_relaxed);
+		if (free_tasks.compare_exchange_weak (
+				head, next, std::memory_order_acquire
+			))
+			return &task;
+	}
 }
 
-void TaskScheduler::submit (std::function<void ()> job) {
+void TaskScheduler::release_task (Task* task) {
+	task->job.reset ();
+	task->group = nullptr;
+	task->next = nullptr;
+
+	if (task->pool_index == 0) {
+		delete task;
+		return;
+	}
+
+	uint64_t head = free_tasks.load (std::memory_order_relaxed);
+	uint64_t next;
+	do {
+		task->next_free.store (
+			static_cast<uint32_t> (head & free_index_mask),
+			std::memory_order_relaxed
+		);
+		next = ((head & ~free_index_mask) + free_tag_step) | task->pool_index;
+	} while (!free_tasks.compare_exchange_weak (
+		head, next, std::memory_order_release
+	));
+}
+
+void TaskScheduler::count_storage (const Job& job) {
+	if (job.get_storage () == JobStorage::Arena)
+		arena_jobs.fetch_add (1, std::memory_order_relaxed);
+	else if (job.get_storage () == JobStorage::Heap)
+		heap_jobs.fetch_add (1, std::memory_order_relaxed);
+}
+
+void TaskScheduler::end_frame () {
+	JobArena* finished = frame_arena.load ();
+	JobArena* next = finished == &frame_arenas[0] ? &frame_arenas[1]
+												   : &frame_arenas[0];
+
+	// Jobs from two frames ago may still hold captures in the next arena,
+	// in which case it stays closed and large captures go to the heap.
+	finished->close ();
+	next->try_reset ();
+	frame_arena.store (next, std::memory_order_release);
+
+	if (config.telemetry)
+		collect_telemetry ();
+
+	JobWaiter* waiter;
 	{
-		std::lock_guard lock (queue_mutex);
-		task_queue.push (std::move (job));
-		if (running) {
-			++busy_tasks;
+		std::lock_guard lock (frame_waiters_mutex);
+		waiter = std::exchange (frame_waiters_head, nullptr);
+		frame_waiters_tail = nullptr;
+	}
+
+	while (waiter) {
+		JobWaiter* next_waiter = waiter->next;
+		waiter->notify (*waiter);
+		waiter = next_waiter;
+	}
+}
+
+void TaskScheduler::defer_to_next_frame (JobWaiter& waiter) {
+	waiter.next = nullptr;
+
+	std::lock_guard lock (frame_waiters_mutex);
+	if (frame_waiters_tail)
+		frame_waiters_tail->next = &waiter;
+	else
+		frame_waiters_head = &waiter;
+	frame_waiters_tail = &waiter;
+}
+
+void TaskScheduler::collect_telemetry () {
+	const uint64_t frame_ns = now_ns ();
+	const float frame_ms
+		= telemetry_frame_ns == 0
+			  ? 0.0f
+			  : static_cast<float> (frame_ns - telemetry_frame_ns) / 1.0e6f;
+	telemetry_frame_ns = frame_ns;
+
+	telemetry.frame_ms = frame_ms;
+	telemetry.queue_wait = {};
+	telemetry.run_time = {};
+
+	telemetry.workers.resize (workers.size ());
+	for (size_t i = 0; i < workers.size (); ++i) {
+		telemetry.workers[i] = workers[i]->telemetry.drain (
+			frame_ms, telemetry.queue_wait, telemetry.run_time
+		);
+		telemetry.workers[i].worker_class = workers[i]->worker_class;
+	}
+	telemetry.caller = caller_telemetry.drain (
+		frame_ms, telemetry.queue_wait, telemetry.run_time
+	);
+
+	for (size_t i = 0; i < lanes.size (); ++i)
+		telemetry.queue_depth[i] = lanes[i].pending_tasks.load (
+			std::memory_order_relaxed
+		);
+}
+
+TaskScheduler::Lane& TaskScheduler::lane_for (const WorkerClass worker_class) {
+	Lane& lane = lanes[static_cast<size_t> (worker_class)];
+	if (lane.worker_count == 0)
+		return lanes[static_cast<size_t> (WorkerClass::Latency)];
+	return lane;
+}
+
+void TaskScheduler::enqueue (Task* task, const WorkerClass worker_class) {
+	++busy_tasks;
+	if (config.telemetry)
+		task->submit_ns = now_ns ();
+
+	Lane& lane = lane_for (worker_class);
+	Worker* worker = on_worker_thread () ? workers[current_worker_index].get ()
+										 : nullptr;
+
+	if (worker && worker->lane == &lane) {
+		worker->deque.push (task);
+		worker->local_pushes.fetch_add (1, std::memory_order_relaxed);
+	} else {
+		if (!lane.injection_mutex.try_lock ()) {
+			injection_contention.fetch_add (1, std::memory_order_relaxed);
+			lane.injection_mutex.lock ();
 		}
+		if (lane.injection_tail)
+			lane.injection_tail->next = task;
+		else
+			lane.injection_head = task;
+		lane.injection_tail = task;
+		lane.injection_mutex.unlock ();
+		injected.fetch_add (1, std::memory_order_relaxed);
 	}
-	if (running)
-		condition_variable.notify_one ();
+
+	lane.pending_tasks.fetch_add (1);
+	wake_one (lane);
+
+	if (blocked_waiters.load () > 0) {
+		std::lock_guard lock (idle_mutex);
+		idle_condition_variable.notify_all ();
+	}
+}
+
+JobHandle TaskScheduler::schedule (
+	Job job, const std::initializer_list<JobHandle> dependencies,
+	TaskGroup* group
+) {
+	return schedule (
+		std::move (job), {dependencies.begin (), dependencies.end ()}, group
+	);
+}
+
+JobHandle TaskScheduler::schedule (
+	Job job, const std::span<const JobHandle> dependencies, TaskGroup* group
+) {
+	assert (job);
+
+	auto node = std::make_shared<JobNode> ();
+	node->scheduler = this;
+	node->work = std::move (job);
+	node->unresolved.store (static_cast<int> (dependencies.size ()) + 1);
+
+	// A refused job still resolves, so its continuations are not stranded.
+	if (group && group->try_add ()) {
+		node->group = group;
+	} else if (group) {
+		node->work.reset ();
+		dropped.fetch_add (1, std::memory_order_relaxed);
+	}
+
+	for (const JobHandle& dependency : dependencies) {
+		if (!dependency.node) {
+			node->unresolved.fetch_sub (1);
+			continue;
+		}
+
+		std::lock_guard lock (dependency.node->continuation_mutex);
+		if (dependency.node->finished.load (std::memory_order_acquire))
+			node->unresolved.fetch_sub (1);
+		else
+			dependency.node->continuations.push_back (node);
+	}
+
+	JobHandle handle (node);
+	release_dependency (std::move (node));
+	return handle;
+}
+
+size_t TaskScheduler::chunk_size_for (
+	const size_t count, const size_t grain
+) const {
+	const Lane& lane = lanes[static_cast<size_t> (current_class ())];
+	const size_t participants = (running ? lane.worker_count : 0) + 1;
+	const size_t target_chunks = participants * 4;
+	const size_t adaptive = (count + target_chunks - 1) / target_chunks;
+	return std::max ({grain, adaptive, size_t{1}});
+}
+
+void TaskScheduler::run_parallel (
+	const size_t begin, const size_t end, const size_t chunk_size,
+	const RangeBody body, void* context
+) {
+	const size_t chunk_count = (end - begin + chunk_size - 1) / chunk_size;
+
+	if (!running || chunk_count == 1) {
+		for (size_t chunk = 0; chunk < chunk_count; ++chunk) {
+			const size_t chunk_begin = begin + chunk * chunk_size;
+			body (
+				context, chunk, chunk_begin,
+				std::min (end, chunk_begin + chunk_size)
+			);
+		}
+		return;
+	}
+
+	// Helpers can be dequeued after the caller returns, so the range is
+	// borrowed from the frame arena rather than the caller's stack.
+	ParallelRange* range = ParallelRange::create (
+		frame_arena.load (std::memory_order_acquire)
+	);
+	range->begin = begin;
+	range->end = end;
+	range->chunk_size = chunk_size;
+	range->chunk_count = chunk_count;
+	range->body = body;
+	range->context = context;
+
+	// Helpers only touch the caller's context while a chunk is still
+	// outstanding, so late starters simply find the range exhausted.
+	const size_t helpers = std::min (
+		lane_for (current_class ()).worker_count, chunk_count - 1
+	);
+	range->references.store (helpers + 1);
+	for (size_t i = 0; i < helpers; ++i)
+		submit ([range] () {
+			range->run ();
+			range->release ();
+		});
+
+	range->run ();
+	range->wait ();
+	range->release ();
+}
+
+void TaskScheduler::release_dependency (std::shared_ptr<JobNode> node) {
+	if (node->unresolved.fetch_sub (1) != 1)
+		return;
+
+	submit ([this, node = std::move (node)] () { run_node (*node); });
+}
+
+void TaskScheduler::run_node (JobNode& node) {
+	if (node.group && node.group->cancelled ())
+		dropped.fetch_add (1, std::memory_order_relaxed);
+	else if (node.work)
+		node.work ();
+
+	std::vector<std::shared_ptr<JobNode>> ready;
+	JobWaiter* waiter;
+	{
+		std::lock_guard lock (node.continuation_mutex);
+		node.finished.store (true, std::memory_order_release);
+		ready.swap (node.continuations);
+		waiter = std::exchange (node.waiters, nullptr);
+	}
+
+	for (auto& continuation : ready)
+		release_dependency (std::move (continuation));
+
+	while (waiter) {
+		JobWaiter* next = waiter->next;
+		waiter->notify (*waiter);
+		waiter = next;
+	}
+
+	finish (node.group);
+}
+
+void TaskScheduler::finish (TaskGroup* group) {
+	if (group)
+		group->finish ();
+
+	std::lock_guard lock (idle_mutex);
+	idle_condition_variable.notify_all ();
+}
+
+bool TaskScheduler::on_worker_thread () const {
+	return current_scheduler == this;
+}
+
+bool TaskScheduler::on_background_worker () const {
+	return on_worker_thread ()
+		   && workers[current_worker_index]->worker_class
+				  == WorkerClass::Background;
 }
 
-void TaskScheduler::do_work () {
+WorkerClass TaskScheduler::current_class () const {
+	return on_worker_thread () ? workers[current_worker_index]->worker_class
+							   : WorkerClass::Latency;
+}
+
+void TaskScheduler::wake_one (Lane& lane) {
+	if (lane.sleeping_workers.load () == 0)
+		return;
+
+	std::lock_guard lock (lane.sleep_mutex);
+	lane.condition_variable.notify_one ();
+}
+
+TaskScheduler::Task* TaskScheduler::pop_injected (Lane& lane) {
+	if (!lane.injection_mutex.try_lock ()) {
+		injection_contention.fetch_add (1, std::memory_order_relaxed);
+		lane.injection_mutex.lock ();
+	}
+
+	Task* task = lane.injection_head;
+	if (task) {
+		lane.injection_head = task->next;
+		if (!lane.injection_head)
+			lane.injection_tail = nullptr;
+		task->next = nullptr;
+	}
+
+	lane.injection_mutex.unlock ();
+	return task;
+}
+
+// Waiting threads that are not workers pass a null thief; they have no
+// deque of their own and are not counted in the per-worker steal stats.
+TaskScheduler::Task* TaskScheduler::steal_task (
+	Lane& lane, uint64_t& random_state, const size_t thief_index,
+	Worker* thief
+) {
+	const size_t first = lane.first_worker;
+	const size_t count = lane.worker_count;
+	if (count < (thief ? 2 : 1))
+		return nullptr;
+
+	const size_t start = next_random (random_state) % count;
+	for (size_t i = 0; i < count; ++i) {
+		const size_t victim = first + (start + i) % count;
+		if (victim == thief_index)
+			continue;
+
+		Task* task = nullptr;
+		if (thief)
+			thief->steal_attempts.fetch_add (1, std::memory_order_relaxed);
+		const StealResult result = workers[victim]->deque.steal (task);
+
+		if (result == StealResult::Success) {
+			if (thief)
+				thief->steals.fetch_add (1, std::memory_order_relaxed);
+			return task;
+		}
+		if (result == StealResult::Contended && thief)
+			thief->steal_contention.fetch_add (1, std::memory_order_relaxed);
+	}
+
+	return nullptr;
+}
+
+TaskScheduler::Task*
+TaskScheduler::find_task (Worker& worker, const size_t worker_index) {
+	Task* task = nullptr;
+	if (worker.deque.pop (task))
+		return task;
+
+	if (worker.lane->pending_tasks.load (std::memory_order_relaxed) <= 0)
+		return nullptr;
+
+	if ((task = pop_injected (*worker.lane)))
+		return task;
+
+	return steal_task (
+		*worker.lane, worker.random_state, worker_index, &worker
+	);
+}
+
+TaskScheduler::Task* TaskScheduler::find_help (Lane& lane) {
+	if (lane.pending_tasks.load (std::memory_order_relaxed) <= 0)
+		return nullptr;
+
+	if (Task* task = pop_injected (lane))
+		return task;
+
+	if (!running)
+		return nullptr;
+	return steal_task (lane, helper_random_state, workers.size (), nullptr);
+}
+
+void TaskScheduler::execute (
+	Lane& lane, Task* task, std::atomic<uint64_t>& executed,
+	WorkerTelemetry& worker_telemetry
+) {
+	lane.pending_tasks.fetch_sub (1);
+
+	TaskGroup* group = task->group;
+	const uint64_t start_ns = config.telemetry ? now_ns () : 0;
+	if (group && group->cancelled ())
+		dropped.fetch_add (1, std::memory_order_relaxed);
+	else if (task->job)
+		task->job ();
+	if (config.telemetry)
+		worker_telemetry.record (
+			start_ns - task->submit_ns, now_ns () - start_ns
+		);
+
+	release_task (task);
+	if (group)
+		finish (group);
+
+	executed.fetch_add (1, std::memory_order_relaxed);
+
+	if (--busy_tasks == 0) {
+		std::lock_guard<std::mutex> lock (idle_mutex);
+		idle_condition_variable.notify_all ();
+	}
+}
+
+void TaskScheduler::do_work (const size_t worker_index) {
+	current_scheduler = this;
+	current_worker_index = worker_index;
+
+	Worker& worker = *workers[worker_index];
+	Lane& lane = *worker.lane;
+	int idle_rounds = 0;
+	bind_scratch_arena (&worker.scratch);
+
 	while (true) {
-		std::function<void ()> task;
-		{
-			std::unique_lock<std::mutex> lock (queue_mutex);
-			condition_variable.wait (lock, [this] {
-				return !running || !task_queue.empty ();
-			});
-
-			if (!running && task_queue.empty ())
-				return;
+		if (Task* task = find_task (worker, worker_index)) {
+			execute (lane, task, worker.executed, worker.telemetry);
+			idle_rounds = 0;
+			continue;
+		}
 
-			task = std::move (task_queue.front ());
-			task_queue.pop ();
+		if (!running && lane.pending_tasks.load () <= 0)
+			break;
+
+		if (++idle_rounds < spin_rounds) {
+			std::this_thread::yield ();
+			continue;
 		}
 
-		if (task) {
-			task ();
-			if (--busy_tasks == 0) {
-				std::lock_guard<std::mutex> lock (idle_mutex);
-				idle_condition_variable.notify_all ();
+		std::unique_lock lock (lane.sleep_mutex);
+		++lane.sleeping_workers;
+		worker.sleeps.fetch_add (1, std::memory_order_relaxed);
+		lane.condition_variable.wait (lock, [this, &lane] {
+			return !running || lane.pending_tasks.load () > 0;
+		});
+		--lane.sleeping_workers;
+		idle_rounds = 0;
+	}
+
+	bind_scratch_arena (nullptr);
+	current_scheduler = nullptr;
+}
+
+void TaskScheduler::wait_idle (const WaitMode mode) {
+	wait_until (mode, [this] { return busy_tasks == 0; });
+}
+
+// A worker that blocks on work queued behind it would deadlock small pools,
+// so waits issued from inside a job keep executing tasks instead.
+template <class Predicate> void TaskScheduler::help_until (Predicate&& done) {
+	Worker& worker = *workers[current_worker_index];
+	while (!done ()) {
+		if (Task* task = find_task (worker, current_worker_index))
+			execute (*worker.lane, task, worker.executed, worker.telemetry);
+		else
+			std::this_thread::yield ();
+	}
+}
+
+// Other threads spin for a while before parking on the idle condition, so
+// short waits skip the futex round trip. Helping callers also wake when new
+// latency work is queued. Before start () or after stop () no worker would
+// ever run queued tasks, so every wait drains them on the caller instead.
+template <class Predicate>
+void TaskScheduler::wait_until (const WaitMode mode, Predicate&& done) {
+	if (on_worker_thread ()) {
+		help_until (done);
+		return;
+	}
+
+	if (!running) {
+		while (!done ()) {
+			bool ran = false;
+			for (Lane& lane : lanes) {
+				if (Task* task = pop_injected (lane)) {
+					execute (lane, task, helped, caller_telemetry);
+					ran = true;
+				}
 			}
+			if (!ran)
+				std::this_thread::yield ();
 		}
+		return;
+	}
+
+	const bool help = mode == WaitMode::Help;
+	Lane& lane = lane_for (WorkerClass::Latency);
+	int idle_rounds = 0;
+
+	while (!done ()) {
+		if (help) {
+			if (Task* task = find_help (lane)) {
+				execute (lane, task, helped, caller_telemetry);
+				idle_rounds = 0;
+				continue;
+			}
+		}
+
+		if (++idle_rounds < spin_rounds) {
+			std::this_thread::yield ();
+			continue;
+		}
+
+		std::unique_lock lock (idle_mutex);
+		if (help)
+			++blocked_waiters;
+		idle_condition_variable.wait (lock, [&] {
+			return done () || (help && lane.pending_tasks.load () > 0);
+		});
+		if (help)
+			--blocked_waiters;
+		idle_rounds = 0;
 	}
 }
 
-void TaskScheduler::wait_idle () {
-	std::unique_lock<std::mutex> lock (idle_mutex);
-	idle_condition_variable.wait (lock, [this] { return busy_tasks == 0; });
-}
\ No newline at end of file
+void TaskScheduler::wait (const TaskGroup& group, const WaitMode mode) {
+	wait_until (mode, [&group] { return group.done (); });
+}
+
+void TaskScheduler::wait (const JobHandle& handle, const WaitMode mode) {
+	wait_until (mode, [&handle] { return handle.done (); });
+}
+
+TaskSchedulerStats TaskScheduler::get_stats () const {
+	TaskSchedulerStats out{};
+	out.injected = injected.load (std::memory_order_relaxed);
+	out.injection_contention = injection_contention.load (
+		std::memory_order_relaxed
+	);
+
+	for (const auto& worker : workers) {
+		out.executed += worker->executed.load (std::memory_order_relaxed);
+		out.local_pushes += worker->local_pushes.load (
+			std::memory_order_relaxed
+		);
+		out.steals += worker->steals.load (std::memory_order_relaxed);
+		out.steal_attempts += worker->steal_attempts.load (
+			std::memory_order_relaxed
+		);
+		out.steal_contention += worker->steal_contention.load (
+			std::memory_order_relaxed
+		);
+		out.sleeps += worker->sleeps.load (std::memory_order_relaxed);
+
+		const ScratchStats scratch = worker->scratch.get_stats ();
+		out.scratch_fallbacks += scratch.fallbacks;
+		out.scratch_high_water = std::max (
+			out.scratch_high_water, scratch.high_water
+		);
+
+		if (worker->worker_class == WorkerClass::Background)
+			out.background_executed += worker->executed.load (
+				std::memory_order_relaxed
+			);
+	}
+
+	out.helped = helped.load (std::memory_order_relaxed);
+	out.dropped = dropped.load (std::memory_order_relaxed);
+	out.executed += out.helped;
+	out.thread_config_failures = thread_config_failures.load ();
+
+	out.arena_jobs = arena_jobs.load (std::memory_order_relaxed);
+	out.heap_jobs = heap_jobs.load (std::memory_order_relaxed);
+	out.task_pool_misses = task_pool_misses.load (std::memory_order_relaxed);
+	out.arena_bytes = frame_arena.load ()->used ();
+
+	out.submitted = out.injected + out.local_pushes;
+	return out;
+}
@@ -1,14 +1,57 @@
 #ifndef TASKS_H
 #define TASKS_H
 
+#include <algorithm>
 #include <atomic>
+#include <array>
 #include <condition_variable>
-#include <functional>
+#include <memory>
 #include <mutex>
-#include <queue>
+#include <optional>
+#include <span>
 #include <thread>
 #include <vector>
 
+#include "arena.h"
+#include "coroutine.h"
+#include "deque.h"
+#include "job.h"
+#include "scratch.h"
+#include "telemetry.h"
+#include "thread.h"
+
+struct TaskSchedulerStats {
+	uint64_t submitted = 0;
+	uint64_t executed = 0;
+
+	uint64_t local_pushes = 0;
+	uint64_t injected = 0;
+
+	uint64_t steals = 0;
+	uint64_t steal_attempts = 0;
+	uint64_t steal_contention = 0;
+	uint64_t injection_contention = 0;
+
+	uint64_t sleeps = 0;
+	uint64_t helped = 0;
+	uint64_t dropped = 0;
+	uint64_t background_executed = 0;
+	uint64_t thread_config_failures = 0;
+
+	uint64_t arena_jobs = 0;
+	uint64_t heap_jobs = 0;
+	uint64_t task_pool_misses = 0;
+	size_t arena_bytes = 0;
+
+	uint64_t scratch_fallbacks = 0;
+	size_t scratch_high_water = 0;
+};
+
+// Block parks a non-worker caller until the wait is satisfied. Help lets it
+// run queued latency jobs meanwhile, so only use it when none of those jobs
+// can block on something the caller does after the wait. Workers always help.
+enum class WaitMode : uint8_t { Block, Help };
+
 class TaskScheduler {
   public:
 	explicit TaskScheduler (
@@ -16,12 +59,58 @@ class TaskScheduler {
 			4, std::max<size_t> (1, std::thread::hardware_concurrency () - 1)
 		)
 	);
+	explicit TaskScheduler (TaskSchedulerConfig config);
 	~TaskScheduler ();
 
-	void submit (std::function<void ()> job);
+	static constexpr uint32_t task_pool_capacity = 4096;
+	static constexpr size_t frame_arena_capacity = 64 * 1024;
+	static constexpr size_t reduce_chunk_capacity = 64;
+
+	template <class Function> void submit (Function&& function);
+	template <class Function>
+	void submit (Function&& function, TaskGroup& group);
+	template <class Function> void submit_background (Function&& function);
+
+	JobHandle schedule (
+		Job job, std::initializer_list<JobHandle> dependencies = {},
+		TaskGroup* group = nullptr
+	);
+	JobHandle schedule (
+		Job job, std::span<const JobHandle> dependencies,
+		TaskGroup* group = nullptr
+	);
+
+	[[nodiscard]] ScheduleAwaiter schedule () { return {*this}; }
+	[[nodiscard]] FrameAwaiter next_frame () { return FrameAwaiter (*this); }
+	void defer_to_next_frame (JobWaiter& waiter);
+
+	void end_frame ();
+
+	// Refreshed by end_frame; read it from the thread that calls end_frame.
+	[[nodiscard]] const TaskSchedulerTelemetry& get_telemetry () const {
+		return telemetry;
+	}
+
 	void start ();
 	void stop ();
-	void wait_idle ();
+	void wait_idle (WaitMode mode = WaitMode::Block);
+	void wait (const TaskGroup& group, WaitMode mode = WaitMode::Block);
+	void wait (const JobHandle& handle, WaitMode mode = WaitMode::Block);
+
+	template <class Function>
+	void parallel_for (
+		size_t begin, size_t end, size_t grain, Function&& function
+	);
+
+	template <class T, class Function, class Reduce>
+	T parallel_reduce (
+		size_t begin, size_t end, size_t grain, T identity,
+		Function&& function, Reduce&& reduce
+	);
+
+	[[nodiscard]] TaskSchedulerStats get_stats () const;
+	[[nodiscard]] bool on_worker_thread () const;
+	[[nodiscard]] bool on_background_worker () const;
 
 	size_t thread_count = 0;
 	std::atomic<bool> running = false;
@@ -31,12 +120,240 @@ class TaskScheduler {
 	std::mutex idle_mutex;
 
   private:
-	void do_work ();
+	struct alignas (64) Task {
+		Job job;
+		TaskGroup* group = nullptr;
+		Task* next = nullptr;
+		uint64_t submit_ns = 0;
+
+		uint32_t pool_index = 0;
+		std::atomic<uint32_t> next_free{0};
+	};
+
+	// Latency and background workers never share tasks, so each class has
+	// its own injection queue and sleep state.
+	struct Lane {
+		Task* injection_head = nullptr;
+		Task* injection_tail = nullptr;
+		std::mutex injection_mutex;
+
+		std::atomic<int64_t> pending_tasks{0};
+		std::atomic<int> sleeping_workers{0};
+		std::mutex sleep_mutex;
+		std::condition_variable condition_variable;
+
+		size_t first_worker = 0;
+		size_t worker_count = 0;
+	};
+
+	struct alignas (64) Worker {
+		explicit Worker (const size_t scratch_bytes)
+			: scratch (scratch_bytes) {}
+
+		WorkStealingDeque<Task*> deque;
+		std::thread thread;
+		Lane* lane = nullptr;
+		WorkerClass worker_class = WorkerClass::Latency;
+		uint64_t random_state = 0;
+
+		std::atomic<uint64_t> executed{0};
+		std::atomic<uint64_t> local_pushes{0};
+		std::atomic<uint64_t> steals{0};
+		std::atomic<uint64_t> steal_attempts{0};
+		std::atomic<uint64_t> steal_contention{0};
+		std::atomic<uint64_t> sleeps{0};
+
+		WorkerTelemetry telemetry;
+		ScratchArena scratch;
+	};
+
+	template <class Function>
+	Task* make_task (Function&& function, TaskGroup* group);
+	Task* acquire_task ();
+	void release_task (Task* task);
+	void count_storage (const Job& job);
+	void enqueue (Task* task, WorkerClass worker_class);
+
+	void do_work (size_t worker_index);
+	Task* find_task (Worker& worker, size_t worker_index);
+	Task* find_help (Lane& lane);
+	Task* pop_injected (Lane& lane);
+	Task* steal_task (
+		Lane& lane, uint64_t& random_state, size_t thief_index, Worker* thief
+	);
+	void execute (
+		Lane& lane, Task* task, std::atomic<uint64_t>& executed,
+		WorkerTelemetry& worker_telemetry
+	);
+	void collect_telemetry ();
+	void wake_one (Lane& lane);
+	Lane& lane_for (WorkerClass worker_class);
+	[[nodiscard]] WorkerClass current_class () const;
 
-	std::vector<std::thread> workers;
-	std::queue<std::function<void ()>> task_queue;
-	std::mutex queue_mutex;
-	std::condition_variable condition_variable;
+	using RangeBody = void (*) (
+		void* context, size_t chunk, size_t chunk_begin, size_t chunk_end
+	);
+
+	[[nodiscard]] size_t chunk_size_for (size_t count, size_t grain) const;
+	void run_parallel (
+		size_t begin, size_t end, size_t chunk_size, RangeBody body,
+		void* context
+	);
+
+	void release_dependency (std::shared_ptr<JobNode> node);
+	void run_node (JobNode& node);
+	void finish (TaskGroup* group);
+
+	template <class Predicate> void help_until (Predicate&& done);
+	template <class Predicate>
+	void wait_until (WaitMode mode, Predicate&& done);
+
+	TaskSchedulerConfig config;
+	std::vector<std::unique_ptr<Worker>> workers;
+	std::array<Lane, 2> lanes;
+	std::atomic<uint64_t> thread_config_failures{0};
+
+	std::array<JobArena, 2> frame_arenas{
+		JobArena (frame_arena_capacity), JobArena (frame_arena_capacity)
+	};
+	std::atomic<JobArena*> frame_arena{&frame_arenas[0]};
+	std::atomic<uint64_t> arena_jobs{0};
+	std::atomic<uint64_t> heap_jobs{0};
+
+	std::unique_ptr<Task[]> task_pool;
+	std::atomic<uint64_t> free_tasks{0};
+	std::atomic<uint64_t> task_pool_misses{0};
+
+	JobWaiter* frame_waiters_head = nullptr;
+	JobWaiter* frame_waiters_tail = nullptr;
+	std::mutex frame_waiters_mutex;
+
+	std::atomic<uint64_t> injected{0};
+	std::atomic<uint64_t> injection_contention{0};
+	std::atomic<uint64_t> helped{0};
+	std::atomic<uint64_t> dropped{0};
+	std::atomic<int> blocked_waiters{0};
+
+	WorkerTelemetry caller_telemetry;
+	TaskSchedulerTelemetry telemetry;
+	uint64_t telemetry_frame_ns = 0;
 };
 
+template <class Function> void TaskScheduler::submit (Function&& function) {
+	enqueue (
+		make_task (std::forward<Function> (function), nullptr),
+		current_class ()
+	);
+}
+
+template <class Function>
+void TaskScheduler::submit (Function&& function, TaskGroup& group) {
+	if (!group.try_add ()) {
+		dropped.fetch_add (1, std::memory_order_relaxed);
+		return;
+	}
+
+	enqueue (
+		make_task (std::forward<Function> (function), &group),
+		current_class ()
+	);
+}
+
+template <class Function>
+void TaskScheduler::submit_background (Function&& function) {
+	enqueue (
+		make_task (std::forward<Function> (function), nullptr),
+		WorkerClass::Background
+	);
+}
+
+template <class Function>
+TaskScheduler::Task*
+TaskScheduler::make_task (Function&& function, TaskGroup* group) {
+	Task* task = acquire_task ();
+	task->job = Job (
+		std::forward<Function> (function),
+		frame_arena.load (std::memory_order_acquire)
+	);
+	task->group = group;
+
+	if (task->job.get_storage () != JobStorage::Inline)
+		count_storage (task->job);
+	return task;
+}
+
+template <class Function>
+void TaskScheduler::parallel_for (
+	const size_t begin, const size_t end, const size_t grain,
+	Function&& function
+) {
+	if (begin >= end)
+		return;
+
+	using Callable = std::remove_reference_t<Function>;
+	struct Range {
+		static void invoke (
+			void* context, size_t, const size_t chunk_begin,
+			const size_t chunk_end
+		) {
+			(*static_cast<Callable*> (context)) (chunk_begin, chunk_end);
+		}
+	};
+
+	void* context = const_cast<void*> (
+		static_cast<const void*> (std::addressof (function))
+	);
+	run_parallel (
+		begin, end, chunk_size_for (end - begin, grain), &Range::invoke,
+		context
+	);
+}
+
+template <class T, class Function, class Reduce>
+T TaskScheduler::parallel_reduce (
+	const size_t begin, const size_t end, const size_t grain, T identity,
+	Function&& function, Reduce&& reduce
+) {
+	if (begin >= end)
+		return identity;
+
+	// Partials live on the caller's stack, one cache line each, so chunks
+	// never share a word; wide ranges get larger chunks instead of slots.
+	const size_t count = end - begin;
+	const size_t chunk_size = std::max (
+		chunk_size_for (count, grain),
+		(count + reduce_chunk_capacity - 1) / reduce_chunk_capacity
+	);
+	const size_t chunk_count = (count + chunk_size - 1) / chunk_size;
+
+	struct alignas (64) Partial {
+		T value;
+	};
+
+	struct Context {
+		std::remove_reference_t<Function>* function;
+		std::array<std::optional<Partial>, reduce_chunk_capacity> partials;
+
+		static void invoke (
+			void* context, const size_t chunk, const size_t chunk_begin,
+			const size_t chunk_end
+		) {
+			auto& self = *static_cast<Context*> (context);
+			self.partials[chunk].emplace (
+				Partial{(*self.function) (chunk_begin, chunk_end)}
+			);
+		}
+	};
+
+	Context context{std::addressof (function), {}};
+	run_parallel (begin, end, chunk_size, &Context::invoke, &context);
+
+	T result = std::move (identity);
+	for (size_t chunk = 0; chunk < chunk_count; ++chunk)
+		result = reduce (
+			std::move (result), std::move (context.partials[chunk]->value)
+		);
+	return result;
+}
+
 #endif // TASKS_H
@@ -0,0 +1,69 @@
+#include "telemetry.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace {
+constexpr unsigned first_bucket_shift = 8;
+}
+
+size_t LatencyHistogram::bucket_for (const uint64_t ns) {
+	const auto bucket = static_cast<size_t> (
+		std::bit_width (ns >> first_bucket_shift)
+	);
+	return std::min (bucket, bucket_count - 1);
+}
+
+uint64_t LatencyHistogram::upper_bound_ns (const size_t bucket) {
+	return uint64_t{1} << (first_bucket_shift + bucket);
+}
+
+float LatencyHistogram::percentile_us (const float quantile) const {
+	if (count == 0)
+		return 0.0f;
+
+	const auto target = static_cast<uint64_t> (
+		std::clamp (quantile, 0.0f, 1.0f) * static_cast<float> (count - 1)
+	);
+
+	uint64_t seen = 0;
+	for (size_t i = 0; i < bucket_count; ++i) {
+		seen += buckets[i];
+		if (seen > target)
+			return static_cast<float> (upper_bound_ns (i)) / 1000.0f;
+	}
+	return static_cast<float> (upper_bound_ns (bucket_count - 1)) / 1000.0f;
+}
+
+WorkerUtilization WorkerTelemetry::drain (
+	const float frame_ms, LatencyHistogram& queue_wait_out,
+	LatencyHistogram& run_time_out
+) {
+	for (size_t i = 0; i < LatencyHistogram::bucket_count; ++i) {
+		const uint64_t waits = queue_wait[i].exchange (
+			0, std::memory_order_relaxed
+		);
+		queue_wait_out.buckets[i] += waits;
+		queue_wait_out.count += waits;
+
+		const uint64_t runs = run_time[i].exchange (
+			0, std::memory_order_relaxed
+		);
+		run_time_out.buckets[i] += runs;
+		run_time_out.count += runs;
+	}
+
+	// Jobs are accounted when they finish, so one spanning frames can
+	// report more busy time than the frame had.
+	WorkerUtilization out;
+	out.jobs = jobs.exchange (0, std::memory_order_relaxed);
+	out.busy_ms = static_cast<float> (
+					  busy_ns.exchange (0, std::memory_order_relaxed)
+				  )
+				  / 1.0e6f;
+	out.idle_ms = std::max (0.0f, frame_ms - out.busy_ms);
+	out.utilization = frame_ms > 0.0f
+						  ? std::min (1.0f, out.busy_ms / frame_ms)
+						  : 0.0f;
+	return out;
+}
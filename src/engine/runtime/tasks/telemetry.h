@@ -0,0 +1,78 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "thread.h"
+
+// Log2 latency buckets. Bucket 0 holds anything under 256 ns and every
+// following bucket doubles the upper bound, so the last one starts at ~67 ms.
+struct LatencyHistogram {
+	static constexpr size_t bucket_count = 20;
+
+	std::array<uint64_t, bucket_count> buckets{};
+	uint64_t count = 0;
+
+	static size_t bucket_for (uint64_t ns);
+	static uint64_t upper_bound_ns (size_t bucket);
+
+	// Upper bound of the bucket holding the given quantile, in microseconds.
+	[[nodiscard]] float percentile_us (float quantile) const;
+};
+
+struct WorkerUtilization;
+
+// Written by the thread that owns it with relaxed atomics and drained once
+// per frame by TaskScheduler::end_frame.
+struct alignas (64) WorkerTelemetry {
+	std::atomic<uint64_t> jobs{0};
+	std::atomic<uint64_t> busy_ns{0};
+	std::array<std::atomic<uint64_t>, LatencyHistogram::bucket_count>
+		queue_wait{};
+	std::array<std::atomic<uint64_t>, LatencyHistogram::bucket_count>
+		run_time{};
+
+	void record (const uint64_t wait_ns, const uint64_t run_ns) {
+		jobs.fetch_add (1, std::memory_order_relaxed);
+		busy_ns.fetch_add (run_ns, std::memory_order_relaxed);
+		queue_wait[LatencyHistogram::bucket_for (wait_ns)].fetch_add (
+			1, std::memory_order_relaxed
+		);
+		run_time[LatencyHistogram::bucket_for (run_ns)].fetch_add (
+			1, std::memory_order_relaxed
+		);
+	}
+
+	WorkerUtilization drain (
+		float frame_ms, LatencyHistogram& queue_wait_out,
+		LatencyHistogram& run_time_out
+	);
+};
+
+struct WorkerUtilization {
+	WorkerClass worker_class = WorkerClass::Latency;
+	uint64_t jobs = 0;
+	float busy_ms = 0.0f;
+	float idle_ms = 0.0f;
+	float utilization = 0.0f;
+};
+
+// One frame worth of scheduler activity. Jobs run by threads that help
+// while waiting are reported in the caller entry.
+struct TaskSchedulerTelemetry {
+	float frame_ms = 0.0f;
+
+	std::vector<WorkerUtilization> workers;
+	WorkerUtilization caller;
+
+	LatencyHistogram queue_wait;
+	LatencyHistogram run_time;
+
+	std::array<int64_t, 2> queue_depth{};
+};
+
+#endif // TELEMETRY_H
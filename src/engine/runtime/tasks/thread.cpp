@@ -0,0 +1,84 @@
+#include "thread.h"
+
+#include <pthread.h>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif defined(__APPLE__)
+#include <pthread/qos.h>
+#endif
+
+namespace {
+bool set_name (const std::string& name) {
+#if defined(__linux__)
+	// Linux limits thread names to 15 characters.
+	return pthread_setname_np (pthread_self (), name.substr (0, 15).c_str ())
+		   == 0;
+#elif defined(__APPLE__)
+	return pthread_setname_np (name.c_str ()) == 0;
+#else
+	(void)name;
+	return false;
+#endif
+}
+
+bool set_policy (const WorkerClass worker_class, const ThreadConfig& config) {
+	if (config.policy == ThreadPolicy::Inherit)
+		return true;
+
+#if defined(__linux__)
+	(void)worker_class;
+	if (config.policy == ThreadPolicy::RealTime) {
+		sched_param param{};
+		param.sched_priority = config.realtime_priority;
+		if (pthread_setschedparam (pthread_self (), SCHED_FIFO, &param) == 0)
+			return true;
+	}
+
+	// Niceness is per thread on Linux. A refused real-time request still
+	// leaves the worker on SCHED_OTHER with the configured nice value.
+	const auto tid = static_cast<id_t> (syscall (SYS_gettid));
+	const bool niced = setpriority (PRIO_PROCESS, tid, config.nice) == 0;
+	return niced && config.policy == ThreadPolicy::Normal;
+#elif defined(__APPLE__)
+	const qos_class_t qos = worker_class == WorkerClass::Latency
+								? QOS_CLASS_USER_INTERACTIVE
+								: QOS_CLASS_UTILITY;
+	return pthread_set_qos_class_self_np (qos, 0) == 0;
+#else
+	(void)worker_class;
+	return false;
+#endif
+}
+
+bool set_affinity (const std::vector<size_t>& cpus) {
+	if (cpus.empty ())
+		return true;
+
+#if defined(__linux__)
+	cpu_set_t set;
+	CPU_ZERO (&set);
+	for (const size_t cpu : cpus)
+		if (cpu < CPU_SETSIZE)
+			CPU_SET (cpu, &set);
+
+	return pthread_setaffinity_np (pthread_self (), sizeof (set), &set) == 0;
+#else
+	// macOS only exposes affinity tags as scheduler hints.
+	return false;
+#endif
+}
+} // namespace
+
+bool configure_current_thread (
+	const std::string& name, const WorkerClass worker_class,
+	const ThreadConfig& config, const std::vector<size_t>& cpus
+) {
+	bool applied = set_name (name);
+	applied &= set_policy (worker_class, config);
+	applied &= set_affinity (cpus);
+	return applied;
+}
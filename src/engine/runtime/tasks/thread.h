@@ -0,0 +1,52 @@
+#ifndef THREAD_H
+#define THREAD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum class WorkerClass : uint8_t { Latency, Background };
+
+enum class ThreadPolicy : uint8_t {
+	Inherit,
+	Normal,
+	RealTime,
+};
+
+struct ThreadConfig {
+	ThreadPolicy policy = ThreadPolicy::Inherit;
+	int nice = 0;
+	int realtime_priority = 1;
+};
+
+struct TaskSchedulerConfig {
+	size_t latency_threads = 1;
+	size_t background_threads = 0;
+
+	std::string name = "worker";
+	ThreadConfig latency{ThreadPolicy::Normal, 0, 1};
+	ThreadConfig background{ThreadPolicy::Normal, 10, 1};
+
+	// Indexed by worker, latency workers first. Missing or empty entries
+	// leave the worker unpinned.
+	std::vector<std::vector<size_t>> affinity;
+
+	// Times every job for the per-frame telemetry; costs two clock reads
+	// per job and one per submit.
+	bool telemetry = true;
+
+	// Per-worker scratch arena; see ScratchArena for sizing it from the
+	// high-water mark.
+	size_t scratch_bytes = 256 * 1024;
+};
+
+// Applies name, scheduling policy and affinity to the calling thread.
+// Returns false when any part is unsupported or was refused by the OS; the
+// remaining settings are still applied.
+bool configure_current_thread (
+	const std::string& name, WorkerClass worker_class,
+	const ThreadConfig& config, const std::vector<size_t>& cpus
+);
+
+#endif // THREAD_H
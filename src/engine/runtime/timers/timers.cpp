@@ -0,0 +1,194 @@
+#include "timers.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include "runtime/tasks/tasks.h"
+
+namespace {
+constexpr uint64_t slot_mask = TimerWheel::slot_count - 1;
+constexpr uint64_t horizon
+	= (uint64_t{1} << (TimerWheel::slot_bits * TimerWheel::level_count)) - 1;
+} // namespace
+
+TimerWheel::TimerWheel (const float tick_ms) : tick_ms (tick_ms) {
+	assert (tick_ms > 0.0f);
+}
+
+TimerHandle TimerWheel::add (const float delay_ms, Job callback) {
+	assert (callback);
+
+	const auto ticks = static_cast<uint64_t> (
+		std::max (1.0f, std::ceil (delay_ms / tick_ms))
+	);
+
+	std::lock_guard lock (mutex);
+
+	uint32_t index;
+	if (!free_nodes.empty ()) {
+		index = free_nodes.back ();
+		free_nodes.pop_back ();
+	} else {
+		nodes.emplace_back ();
+		index = static_cast<uint32_t> (nodes.size ());
+	}
+
+	Node& timer = node (index);
+	timer.callback = std::move (callback);
+	timer.expiry = tick + ticks;
+	timer.active = true;
+	link (index);
+
+	++active_count;
+	stats.scheduled++;
+	return {index, timer.generation};
+}
+
+bool TimerWheel::cancel (const TimerHandle handle) {
+	std::lock_guard lock (mutex);
+	if (handle.index == none || handle.index > nodes.size ())
+		return false;
+
+	const Node& timer = node (handle.index);
+	if (!timer.active || timer.generation != handle.generation)
+		return false;
+
+	unlink (handle.index);
+	release (handle.index);
+	stats.cancelled++;
+	return true;
+}
+
+bool TimerWheel::pending (const TimerHandle handle) const {
+	std::lock_guard lock (mutex);
+	if (handle.index == none || handle.index > nodes.size ())
+		return false;
+
+	const Node& timer = node (handle.index);
+	return timer.active && timer.generation == handle.generation;
+}
+
+void TimerWheel::update (
+	const float delta_time_ms, TaskScheduler& scheduler
+) {
+	join (scheduler);
+	expired.clear ();
+
+	{
+		std::lock_guard lock (mutex);
+		accumulated_ms += delta_time_ms;
+		while (accumulated_ms >= tick_ms) {
+			accumulated_ms -= tick_ms;
+			advance_tick ();
+		}
+		stats.expired += expired.size ();
+		stats.batches += (expired.size () + dispatch_batch - 1)
+						 / dispatch_batch;
+	}
+
+	for (size_t begin = 0; begin < expired.size (); begin += dispatch_batch) {
+		const size_t end = std::min (expired.size (), begin + dispatch_batch);
+		scheduler.submit (
+			[this, begin, end] () {
+				for (size_t i = begin; i < end; ++i)
+					expired[i] ();
+			},
+			group
+		);
+	}
+}
+
+void TimerWheel::join (TaskScheduler& scheduler) {
+	if (!group.done ())
+		scheduler.wait (group);
+}
+
+size_t TimerWheel::size () const {
+	std::lock_guard lock (mutex);
+	return active_count;
+}
+
+TimerStats TimerWheel::get_stats () const {
+	std::lock_guard lock (mutex);
+	return stats;
+}
+
+// Level L holds deadlines between 64^L and 64^(L+1) ticks away, filed by
+// the digit of the deadline at that level.
+void TimerWheel::link (const uint32_t index) {
+	Node& timer = node (index);
+	const uint64_t delta = timer.expiry > tick ? timer.expiry - tick : 0;
+
+	size_t level = 0;
+	while (level + 1 < level_count
+		   && delta >= uint64_t{1} << (slot_bits * (level + 1)))
+		++level;
+
+	const uint64_t due = tick + std::min (delta, horizon);
+	timer.slot = static_cast<uint16_t> (
+		level * slot_count + ((due >> (slot_bits * level)) & slot_mask)
+	);
+
+	uint32_t& head = slots[timer.slot];
+	timer.previous = none;
+	timer.next = head;
+	if (head != none)
+		node (head).previous = index;
+	head = index;
+}
+
+void TimerWheel::unlink (const uint32_t index) {
+	const Node& timer = node (index);
+
+	if (timer.previous != none)
+		node (timer.previous).next = timer.next;
+	else
+		slots[timer.slot] = timer.next;
+
+	if (timer.next != none)
+		node (timer.next).previous = timer.previous;
+}
+
+void TimerWheel::release (const uint32_t index) {
+	Node& timer = node (index);
+	timer.callback.reset ();
+	timer.active = false;
+	timer.generation++;
+
+	free_nodes.push_back (index);
+	--active_count;
+}
+
+void TimerWheel::advance_tick () {
+	++tick;
+	if ((tick & slot_mask) == 0)
+		cascade (1);
+
+	uint32_t index = std::exchange (slots[tick & slot_mask], none);
+	while (index != none) {
+		Node& timer = node (index);
+		assert (timer.expiry <= tick);
+
+		const uint32_t next = timer.next;
+		expired.push_back (std::move (timer.callback));
+		release (index);
+		index = next;
+	}
+}
+
+// Moves the slot the wheel just reached down to finer levels. Outer levels
+// go first so their timers can land in the slot handled next.
+void TimerWheel::cascade (const size_t level) {
+	const uint64_t slot = (tick >> (slot_bits * level)) & slot_mask;
+	if (slot == 0 && level + 1 < level_count)
+		cascade (level + 1);
+
+	uint32_t index = std::exchange (slots[level * slot_count + slot], none);
+	while (index != none) {
+		const uint32_t next = node (index).next;
+		link (index);
+		stats.cascaded++;
+		index = next;
+	}
+}
@@ -0,0 +1,100 @@
+#ifndef TIMERS_H
+#define TIMERS_H
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "runtime/tasks/job.h"
+
+class TaskScheduler;
+
+struct TimerHandle {
+	uint32_t index = 0;
+	uint32_t generation = 0;
+
+	[[nodiscard]] bool valid () const noexcept { return index != 0; }
+};
+
+struct TimerStats {
+	uint64_t scheduled = 0;
+	uint64_t cancelled = 0;
+	uint64_t expired = 0;
+	uint64_t cascaded = 0;
+	uint64_t batches = 0;
+};
+
+// Hierarchical timing wheel. Four levels of 64 slots cover 2^24 ticks;
+// later deadlines park in the outermost level and are re-filed as it turns.
+// Adding and cancelling are O(1) and a tick only touches the slots it
+// crosses, so idle timers cost nothing per frame. Expired callbacks are run
+// on the TaskScheduler in batches and are visible after join ().
+class TimerWheel {
+  public:
+	static constexpr size_t level_count = 4;
+	static constexpr size_t slot_bits = 6;
+	static constexpr size_t slot_count = size_t{1} << slot_bits;
+	static constexpr size_t dispatch_batch = 64;
+
+	explicit TimerWheel (float tick_ms = 1.0f);
+
+	TimerWheel (const TimerWheel&) = delete;
+	TimerWheel& operator= (const TimerWheel&) = delete;
+
+	// Safe to call from timer callbacks, e.g. to re-arm a cooldown.
+	TimerHandle add (float delay_ms, Job callback);
+	bool cancel (TimerHandle handle);
+	[[nodiscard]] bool pending (TimerHandle handle) const;
+
+	// Expires every timer that is due and queues the callbacks. Waits for
+	// the previous batch first, so a callback never overlaps its successor.
+	void update (float delta_time_ms, TaskScheduler& scheduler);
+	void join (TaskScheduler& scheduler);
+
+	[[nodiscard]] size_t size () const;
+	[[nodiscard]] uint64_t get_tick () const { return tick; }
+	[[nodiscard]] TimerStats get_stats () const;
+
+  private:
+	static constexpr uint32_t none = 0;
+
+	struct Node {
+		Job callback;
+		uint64_t expiry = 0;
+		uint32_t previous = none;
+		uint32_t next = none;
+		uint32_t generation = 0;
+		uint16_t slot = 0;
+		bool active = false;
+	};
+
+	Node& node (const uint32_t index) { return nodes[index - 1]; }
+	[[nodiscard]] const Node& node (const uint32_t index) const {
+		return nodes[index - 1];
+	}
+
+	void link (uint32_t index);
+	void unlink (uint32_t index);
+	void release (uint32_t index);
+
+	void advance_tick ();
+	void cascade (size_t level);
+
+	float tick_ms;
+	float accumulated_ms = 0.0f;
+	uint64_t tick = 0;
+
+	std::vector<Node> nodes;
+	std::vector<uint32_t> free_nodes;
+	std::array<uint32_t, level_count * slot_count> slots{};
+	size_t active_count = 0;
+
+	std::vector<Job> expired;
+	TaskGroup group;
+
+	mutable std::mutex mutex;
+	TimerStats stats;
+};
+
+#endif // TIMERS_H
@@ -1,4 +1,5 @@
 #include "assets/asset.h"
+#include "core/memory/allocations.h"
 #include "engine.h"
 #include "entity/prefabs/spheres.h"
 #include "entity/prefabs/static.h"
@@ -9,10 +10,49 @@
 #include "core/math/geometry/plane.h"
 #include "core/math/geometry/sphere.h"
 
+#include <cstdlib>
 #include <memory>
+#include <new>
 
 #include "assets/mesh/mesh.h"
 
+// Counted for the Stats panel. The nothrow forms forward to these.
+void* operator new (const size_t size) {
+	count_heap_allocation ();
+	if (void* memory = std::malloc (size ? size : 1))
+		return memory;
+	throw std::bad_alloc ();
+}
+void* operator new (const size_t size, const std::align_val_t alignment) {
+	count_heap_allocation ();
+	if (void* memory = aligned_malloc (
+			size, static_cast<size_t> (alignment)
+		))
+		return memory;
+	throw std::bad_alloc ();
+}
+void* operator new[] (const size_t size) { return operator new (size); }
+void* operator new[] (const size_t size, const std::align_val_t alignment) {
+	return operator new (size, alignment);
+}
+
+void operator delete (void* memory) noexcept { std::free (memory); }
+void operator delete[] (void* memory) noexcept { std::free (memory); }
+void operator delete (void* memory, size_t) noexcept { std::free (memory); }
+void operator delete[] (void* memory, size_t) noexcept { std::free (memory); }
+void operator delete (void* memory, std::align_val_t) noexcept {
+	aligned_free (memory);
+}
+void operator delete[] (void* memory, std::align_val_t) noexcept {
+	aligned_free (memory);
+}
+void operator delete (void* memory, size_t, std::align_val_t) noexcept {
+	aligned_free (memory);
+}
+void operator delete[] (void* memory, size_t, std::align_val_t) noexcept {
+	aligned_free (memory);
+}
+
 int main () {
 	std::unique_ptr<Engine> engine = std::make_unique<Engine> ();
 	std::unique_ptr<Scene> scene = std::make_unique<Scene> ();
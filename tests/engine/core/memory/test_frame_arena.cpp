@@ -0,0 +1,42 @@
+#include "core/memory/frame_arena.h"
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <memory_resource>
+#include <vector>
+
+TEST (FrameArenaTest, BumpsAlignedAllocationsAndRewinds) {
+	FrameArena arena (1024);
+
+	void* first = arena.allocate (3, 1);
+	void* second = arena.allocate (16, 16);
+	EXPECT_EQ (reinterpret_cast<uintptr_t> (second) % 16, 0u);
+	EXPECT_EQ (
+		static_cast<std::byte*> (second) - static_cast<std::byte*> (first), 16
+	);
+	EXPECT_EQ (arena.used (), 32u);
+
+	arena.reset ();
+	EXPECT_EQ (arena.used (), 0u);
+	EXPECT_EQ (arena.allocate (8, 8), first);
+}
+
+TEST (FrameArenaTest, GrowsToThePeakAfterSpilling) {
+	FrameArena arena (256);
+	const auto fill = [&arena] {
+		std::pmr::vector<int> values (&arena);
+		for (int i = 0; i < 200; ++i)
+			values.push_back (i);
+		EXPECT_EQ (values[199], 199);
+	};
+
+	fill ();
+	EXPECT_GT (arena.get_spills (), 0u);
+
+	arena.reset ();
+	EXPECT_GT (arena.size (), 256u);
+
+	const uint64_t spills = arena.get_spills ();
+	fill ();
+	EXPECT_EQ (arena.get_spills (), spills);
+}
@@ -0,0 +1,109 @@
+#include "core/queues/mpmc.h"
+#include "core/queues/spsc.h"
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+TEST (MpmcQueueTest, RejectsPushWhenFullAndPopsInOrder) {
+	MpmcQueue<int> queue (4);
+	for (int i = 0; i < 4; ++i)
+		EXPECT_TRUE (queue.try_push (i));
+	EXPECT_FALSE (queue.try_push (4));
+	EXPECT_EQ (queue.size_approx (), 4);
+
+	int value = -1;
+	for (int i = 0; i < 4; ++i) {
+		ASSERT_TRUE (queue.try_pop (value));
+		EXPECT_EQ (value, i);
+	}
+	EXPECT_FALSE (queue.try_pop (value));
+	EXPECT_TRUE (queue.empty ());
+}
+
+TEST (MpmcQueueTest, MovesOwningValuesThroughTheRing) {
+	MpmcQueue<std::unique_ptr<int>> queue (2);
+	for (int round = 0; round < 5; ++round) {
+		ASSERT_TRUE (queue.try_push (std::make_unique<int> (round)));
+
+		std::unique_ptr<int> out;
+		ASSERT_TRUE (queue.try_pop (out));
+		ASSERT_NE (out, nullptr);
+		EXPECT_EQ (*out, round);
+	}
+}
+
+TEST (MpmcQueueTest, ManyProducersAndConsumersSeeEveryItemOnce) {
+	constexpr int producers = 4;
+	constexpr int consumers = 4;
+	constexpr int per_producer = 20000;
+	constexpr int total = producers * per_producer;
+
+	MpmcQueue<int> queue (64);
+	std::vector<std::atomic<int>> seen (total);
+	std::atomic<int> popped{0};
+
+	std::vector<std::thread> threads;
+	for (int p = 0; p < producers; ++p)
+		threads.emplace_back ([&, p] {
+			for (int i = 0; i < per_producer; ++i)
+				while (!queue.try_push (p * per_producer + i))
+					std::this_thread::yield ();
+		});
+	for (int c = 0; c < consumers; ++c)
+		threads.emplace_back ([&] {
+			int value;
+			while (popped.load () < total) {
+				if (queue.try_pop (value)) {
+					seen[value].fetch_add (1);
+					popped.fetch_add (1);
+				} else {
+					std::this_thread::yield ();
+				}
+			}
+		});
+	for (std::thread& thread : threads)
+		thread.join ();
+
+	for (int i = 0; i < total; ++i)
+		ASSERT_EQ (seen[i].load (), 1) << i;
+	EXPECT_TRUE (queue.empty ());
+}
+
+TEST (SpscQueueTest, RejectsPushWhenFull) {
+	SpscQueue<int> queue (2);
+	EXPECT_TRUE (queue.try_push (1));
+	EXPECT_TRUE (queue.try_push (2));
+	EXPECT_FALSE (queue.try_push (3));
+
+	int value = 0;
+	ASSERT_TRUE (queue.try_pop (value));
+	EXPECT_EQ (value, 1);
+	EXPECT_TRUE (queue.try_push (3));
+}
+
+TEST (SpscQueueTest, ConsumerSeesProducerOrder) {
+	constexpr int count = 100000;
+	SpscQueue<int> queue (128);
+
+	std::thread producer ([&] {
+		for (int i = 0; i < count; ++i)
+			while (!queue.try_push (i))
+				std::this_thread::yield ();
+	});
+
+	int expected = 0;
+	int value;
+	while (expected < count) {
+		if (!queue.try_pop (value)) {
+			std::this_thread::yield ();
+			continue;
+		}
+		ASSERT_EQ (value, expected);
+		++expected;
+	}
+	producer.join ();
+	EXPECT_TRUE (queue.empty ());
+}
@@ -4,6 +4,8 @@
 #include "core/storage/state.h"
 
 struct FakeState final : IState<FakeState> {
+	static inline int clones = 0;
+
 	int v = 0;
 
 	explicit FakeState (const int v = 0) : v (v) {}
@@ -15,6 +17,7 @@ struct FakeState final : IState<FakeState> {
 	bool equals (const FakeState& other) const override { return v == other.v; }
 
 	std::unique_ptr<FakeState> clone () const override {
+		++clones;
 		return std::make_unique<FakeState> (*this);
 	}
 };
@@ -44,4 +47,10 @@ class FakeFactory {
 	std::vector<uint32_t> destroyed_ids;
 };
 
+// Every handle costs 100 bytes against a budget.
+class SizedFakeFactory : public FakeFactory {
+  public:
+	uint64_t bytes (Handle) const { return 100; }
+};
+
 #endif // FIXTURES_H
@@ -19,11 +19,13 @@ TEST_F (CacheTest, GetOrCreateReturnsSameHandleForEqualState) {
 	const FakeState state_1{42};
 	const FakeState state_2{42};
 
+	const int clones = FakeState::clones;
 	const Handle handle_1 = cache.get_or_create (state_1);
 	const Handle handle_2 = cache.get_or_create (state_2);
 
 	EXPECT_EQ (handle_1.id, handle_2.id);
 	EXPECT_EQ (factory->created_states.size (), 1u);
+	EXPECT_EQ (FakeState::clones - clones, 1);
 }
 
 TEST_F (CacheTest, GetOrCreateCreatesNewHandleForDifferentState) {
@@ -55,4 +57,31 @@ TEST_F (CacheTest, ClearDestroysAllCachedHandles) {
 		(factory->destroyed_ids[0] == handle_2.id
 		 || factory->destroyed_ids[1] == handle_2.id)
 	);
-}
\ No newline at end of file
+}
+
+TEST_F (CacheTest, OverBudgetEvictsOnlyReleasedEntries) {
+	const auto factory = std::make_shared<SizedFakeFactory> ();
+	Cache<FakeState, SizedFakeFactory> cache (factory, 250);
+
+	const Handle handle_1 = cache.get_or_create (FakeState{1});
+	const Handle handle_2 = cache.get_or_create (FakeState{2});
+	const Handle handle_3 = cache.get_or_create (FakeState{3});
+
+	cache.release (FakeState{2});
+	EXPECT_EQ (factory->destroyed_ids, (std::vector<uint32_t>{handle_2.id}));
+
+	cache.release (FakeState{1});
+	EXPECT_EQ (cache.get_or_create (FakeState{1}).id, handle_1.id);
+	(void)cache.get_or_create (FakeState{4});
+	EXPECT_EQ (cache.get_stats ().live_bytes, 300u);
+	EXPECT_EQ (factory->destroyed_ids.size (), 1u);
+
+	cache.release (FakeState{3});
+	EXPECT_EQ (
+		factory->destroyed_ids,
+		(std::vector<uint32_t>{handle_2.id, handle_3.id})
+	);
+	EXPECT_EQ (cache.get_stats ().evictions, 2u);
+	EXPECT_EQ (cache.get_stats ().evicted_bytes, 200u);
+	EXPECT_EQ (cache.get_stats ().live_bytes, 200u);
+}
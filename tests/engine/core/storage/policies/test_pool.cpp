@@ -64,4 +64,83 @@ TEST_F (PoolTest, ClearDestroysAllFreeHandles) {
 	pool.clear ();
 
 	EXPECT_EQ (factory->destroyed_ids.size (), 2u);
-}
\ No newline at end of file
+}
+
+TEST_F (PoolTest, OnlyNewBucketsCloneTheState) {
+	const auto factory = std::make_shared<FakeFactory> ();
+	Pool<FakeState, FakeFactory> pool (*factory);
+
+	const FakeState state{5};
+	const int clones = FakeState::clones;
+	for (int i = 0; i < 10; ++i)
+		pool.release (state, pool.acquire (state));
+	ASSERT_NE (pool.get_bucket_stats (state), nullptr);
+
+	EXPECT_EQ (FakeState::clones - clones, 1);
+	EXPECT_EQ (pool.get_bucket_stats (state)->hits, 9u);
+	EXPECT_EQ (pool.get_bucket_free_count (state), 1u);
+}
+
+TEST_F (PoolTest, MissesDoNotCreateBuckets) {
+	const auto factory = std::make_shared<FakeFactory> ();
+	Pool<FakeState, FakeFactory> pool (*factory);
+
+	for (int i = 0; i < 100; ++i)
+		(void)pool.acquire (FakeState{i});
+
+	EXPECT_EQ (pool.get_stats ().misses, 100u);
+	EXPECT_EQ (pool.get_stats ().live_buckets, 0u);
+	EXPECT_EQ (pool.get_bucket_stats (FakeState{0}), nullptr);
+
+	pool.release (FakeState{0}, pool.acquire (FakeState{0}));
+	EXPECT_EQ (pool.get_stats ().live_buckets, 1u);
+}
+
+TEST_F (PoolTest, OverBudgetEvictsLeastRecentlyReleased) {
+	SizedFakeFactory factory;
+	Pool<FakeState, SizedFakeFactory> pool (factory, 250);
+
+	const FakeState states[] = {FakeState{1}, FakeState{2}, FakeState{3}};
+	Handle handles[3];
+	for (int i = 0; i < 3; ++i)
+		handles[i] = pool.acquire (states[i]);
+	for (int i = 0; i < 3; ++i)
+		pool.release (states[i], handles[i]);
+
+	const PoolStats& stats = pool.get_stats ();
+	EXPECT_EQ (stats.evictions, 1u);
+	EXPECT_EQ (stats.evicted_bytes, 100u);
+	EXPECT_EQ (stats.free_bytes, 200u);
+	EXPECT_EQ (factory.destroyed_ids, (std::vector<uint32_t>{handles[0].id}));
+	EXPECT_EQ (pool.get_bucket_stats (states[0]), nullptr);
+	EXPECT_EQ (stats.live_buckets, 2u);
+
+	EXPECT_EQ (pool.acquire (states[2]).id, handles[2].id);
+	EXPECT_EQ (stats.free_bytes, 100u);
+
+	pool.set_budget (50);
+	EXPECT_EQ (stats.evictions, 2u);
+	EXPECT_EQ (stats.free_handles, 0u);
+}
+
+TEST_F (PoolTest, HandlesReleasedInFlightWaitForTheirFrame) {
+	FakeFactory factory;
+	Pool<FakeState, FakeFactory> pool (factory);
+	const FakeState state{1};
+
+	pool.begin_frame (1);
+	const Handle first = pool.acquire (state);
+	pool.release (state, first);
+
+	const Handle second = pool.acquire (state);
+	EXPECT_NE (second.id, first.id);
+	EXPECT_EQ (pool.get_stats ().in_flight_misses, 1u);
+
+	pool.begin_frame (2);
+	pool.release (state, second);
+	pool.end_frame (1);
+
+	EXPECT_EQ (pool.acquire (state).id, first.id);
+	EXPECT_EQ (pool.get_bucket_free_count (state), 1u);
+	EXPECT_EQ (factory.created_states.size (), 2u);
+}
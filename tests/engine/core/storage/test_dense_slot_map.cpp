@@ -136,3 +136,32 @@ TEST_F (DenseSlotMapTest, DeathOnDifferentRecordSizeOrAlign) {
 		".*"
 	);
 }
+
+TEST_F (DenseSlotMapTest, FreeSwapsLastRecordIntoTheHole) {
+	Handle handles[3];
+	for (uint32_t i = 0; i < 3; ++i) {
+		handles[i] = map.allocate (sizeof (TestRecord), alignof (TestRecord));
+		static_cast<TestRecord*> (map.try_get (handles[i]))->a = i + 10;
+	}
+
+	ASSERT_TRUE (map.free (handles[0]));
+
+	const std::span<TestRecord> records = map.records<TestRecord> ();
+	ASSERT_EQ (records.size (), 2u);
+	EXPECT_EQ (records[0].a, 12u);
+	EXPECT_EQ (records[1].a, 11u);
+
+	for (size_t i = 0; i < records.size (); ++i)
+		EXPECT_EQ (map.try_get (map.handle_at (i)), &records[i]);
+	EXPECT_EQ (static_cast<TestRecord*> (map.try_get (handles[2]))->a, 12u);
+	EXPECT_EQ (map.get_stats ().live, 2u);
+	EXPECT_EQ (map.get_stats ().bytes_live, 2 * sizeof (TestRecord));
+}
+
+TEST_F (DenseSlotMapTest, RecordStorageGrowsGeometrically) {
+	for (int i = 0; i < 17; ++i)
+		(void)map.allocate (sizeof (TestRecord), alignof (TestRecord));
+
+	EXPECT_EQ (map.get_stats ().bytes_reserved, 32 * sizeof (TestRecord));
+	EXPECT_EQ (map.size (), 17u);
+}
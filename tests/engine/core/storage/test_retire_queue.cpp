@@ -0,0 +1,30 @@
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "core/storage/lifetime/retire.h"
+
+TEST (RetireQueueTest, CollectsOnlyCompletedFramesInOrder) {
+	RetireQueue<int> queue;
+	queue.retire (1, 10);
+	queue.retire (1, 11);
+	queue.retire (2, 20);
+	queue.retire (4, 40);
+
+	std::vector<int> freed;
+	const auto free = [&] (const int value) { freed.push_back (value); };
+
+	EXPECT_EQ (queue.collect (0, free), 0u);
+	EXPECT_EQ (queue.collect (2, free), 3u);
+	EXPECT_EQ (freed, (std::vector<int>{10, 11, 20}));
+	EXPECT_EQ (queue.size (), 1u);
+
+	EXPECT_EQ (queue.collect (3, free), 0u);
+	EXPECT_EQ (queue.flush (free), 1u);
+	EXPECT_TRUE (queue.empty ());
+
+	const RetireStats& stats = queue.get_stats ();
+	EXPECT_EQ (stats.retired, 4u);
+	EXPECT_EQ (stats.collected, 4u);
+	EXPECT_EQ (stats.pending, 0u);
+	EXPECT_EQ (stats.peak_pending, 4u);
+}
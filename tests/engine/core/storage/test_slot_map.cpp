@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include <string>
+
+#include "core/storage/maps/slot_map.h"
+
+namespace {
+struct Tracked {
+	static inline int alive = 0;
+
+	Tracked () { ++alive; }
+	explicit Tracked (std::string name) : name (std::move (name)) { ++alive; }
+	Tracked (Tracked&& other) noexcept : name (std::move (other.name)) {
+		++alive;
+	}
+	Tracked& operator= (Tracked&&) noexcept = default;
+	~Tracked () { --alive; }
+
+	std::string name;
+};
+} // namespace
+
+class SlotMapTest : public ::testing::Test {
+  protected:
+	void SetUp () override { Tracked::alive = 0; }
+
+	SlotMap<Tracked> map;
+};
+
+TEST_F (SlotMapTest, ConstructsInPlaceAndDestroysOnErase) {
+	const Handle first = map.emplace ("first");
+	const Handle second = map.emplace ("second");
+	const Handle third = map.emplace ("third");
+	EXPECT_EQ (Tracked::alive, 3);
+
+	ASSERT_TRUE (map.erase (first));
+	EXPECT_EQ (Tracked::alive, 2);
+	EXPECT_EQ (map.get (first), nullptr);
+	EXPECT_FALSE (map.erase (first));
+
+	// The last value moved into the hole; its handle still finds it.
+	ASSERT_NE (map.get (third), nullptr);
+	EXPECT_EQ (map.get (third)->name, "third");
+	EXPECT_EQ (map.get (second)->name, "second");
+	EXPECT_EQ (map.records ()[0].name, "third");
+	EXPECT_EQ (map.handle_at (0).id, third.id);
+
+	map.clear ();
+	EXPECT_EQ (Tracked::alive, 0);
+}
+
+TEST_F (SlotMapTest, ReusedIdsGetANewGeneration) {
+	const Handle old_handle = map.emplace ("old");
+	ASSERT_TRUE (map.erase (old_handle));
+
+	const Handle new_handle = map.emplace ("new");
+	EXPECT_EQ (new_handle.id, old_handle.id);
+	EXPECT_NE (new_handle.generation, old_handle.generation);
+	EXPECT_FALSE (map.contains (old_handle));
+	EXPECT_EQ (map.get (new_handle)->name, "new");
+}
+
+TEST_F (SlotMapTest, ServesTypeErasedCallersThroughIStorage) {
+	IStorage& storage = map;
+
+	const Handle handle = storage.allocate (
+		sizeof (Tracked), alignof (Tracked)
+	);
+	ASSERT_TRUE (storage.valid (handle));
+	EXPECT_EQ (storage.try_get (handle), map.get (handle));
+	EXPECT_EQ (Tracked::alive, 1);
+
+	EXPECT_TRUE (storage.free (handle));
+	EXPECT_FALSE (storage.valid (handle));
+	EXPECT_EQ (Tracked::alive, 0);
+	EXPECT_EQ (map.get_stats ().frees, 1u);
+}
@@ -0,0 +1,92 @@
+#include "render/snapshot.h"
+
+#include <gtest/gtest.h>
+#include <thread>
+
+namespace {
+void fill (RenderState& state, const float frame) {
+	state.simulation_time_ms = frame;
+	state.drawables.resize (4);
+	for (Drawable& drawable : state.drawables)
+		drawable.model = glm::mat4 (frame);
+}
+} // namespace
+
+TEST (RenderStateBufferTest, NothingToAcquireBeforeFirstPublish) {
+	RenderStateBuffer buffer;
+
+	EXPECT_FALSE (buffer.has_snapshot ());
+	EXPECT_EQ (buffer.acquire (), nullptr);
+}
+
+TEST (RenderStateBufferTest, AcquireReturnsLatestPublishedSnapshot) {
+	RenderStateBuffer buffer;
+
+	fill (buffer.write_slot (), 1.0f);
+	buffer.publish ();
+	fill (buffer.write_slot (), 2.0f);
+	buffer.publish ();
+
+	const RenderState* state = buffer.acquire ();
+	ASSERT_NE (state, nullptr);
+	EXPECT_EQ (state->simulation_time_ms, 2.0f);
+	EXPECT_EQ (buffer.get_stats ().skipped, 1u);
+}
+
+TEST (RenderStateBufferTest, RepeatsLastSnapshotWhenNothingNewWasPublished) {
+	RenderStateBuffer buffer;
+
+	fill (buffer.write_slot (), 1.0f);
+	buffer.publish ();
+
+	const RenderState* first = buffer.acquire ();
+	const RenderState* second = buffer.acquire ();
+	EXPECT_EQ (first, second);
+
+	// The writer never touches the slot being read.
+	EXPECT_NE (&buffer.write_slot (), first);
+	EXPECT_EQ (buffer.get_stats ().repeated, 1u);
+}
+
+TEST (RenderStateBufferTest, ResetDropsSnapshotsFromThePreviousScene) {
+	RenderStateBuffer buffer;
+
+	fill (buffer.write_slot (), 1.0f);
+	buffer.publish ();
+	buffer.acquire ();
+	buffer.reset ();
+
+	EXPECT_FALSE (buffer.has_snapshot ());
+	EXPECT_EQ (buffer.acquire (), nullptr);
+}
+
+TEST (RenderStateBufferTest, ReaderNeverSeesTornSnapshots) {
+	RenderStateBuffer buffer;
+	constexpr int frames = 20000;
+
+	std::thread producer ([&buffer] {
+		for (int frame = 1; frame <= frames; ++frame) {
+			fill (buffer.write_slot (), static_cast<float> (frame));
+			buffer.publish ();
+		}
+	});
+
+	float last = 0.0f;
+	bool consistent = true;
+	while (last < frames) {
+		const RenderState* state = buffer.acquire ();
+		if (!state)
+			continue;
+
+		for (const Drawable& drawable : state->drawables)
+			consistent &= drawable.model[0][0] == state->simulation_time_ms;
+		consistent &= state->simulation_time_ms >= last;
+		last = state->simulation_time_ms;
+	}
+	producer.join ();
+
+	EXPECT_TRUE (consistent);
+	const RenderStateStats stats = buffer.get_stats ();
+	EXPECT_EQ (stats.published, static_cast<uint64_t> (frames));
+	EXPECT_EQ (stats.consumed + stats.skipped, stats.published);
+}
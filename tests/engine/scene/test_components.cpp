@@ -0,0 +1,83 @@
+#include "entity/components/prefabs/instancing.h"
+#include "entity/components/prefabs/wave.h"
+#include "runtime/tasks/tasks.h"
+
+#include <glm/glm.hpp>
+#include <gtest/gtest.h>
+
+class ComponentsTest : public ::testing::Test {
+  protected:
+	void SetUp () override {
+		for (int i = 0; i < 5000; ++i) {
+			Transform transform;
+			transform.position = glm::vec3 (
+				static_cast<float> (i % 71), 0.0f, static_cast<float> (i / 71)
+			);
+			serial.instances.push_back (transform);
+		}
+		parallel.instances = serial.instances;
+
+		task_scheduler.start ();
+	}
+
+	void TearDown () override { task_scheduler.stop (); }
+
+	TaskScheduler task_scheduler{4};
+	InstancingComponent serial;
+	InstancingComponent parallel;
+};
+
+TEST_F (ComponentsTest, ParallelWaveMatchesSerialWave) {
+	const WaveComponent wave (glm::vec3 (3.0f, 0.0f, 4.0f), 0.5f);
+
+	wave.apply (serial, 1.25f);
+	wave.apply (parallel, 1.25f, &task_scheduler);
+
+	ASSERT_EQ (serial.instances.size (), parallel.instances.size ());
+	for (size_t i = 0; i < serial.instances.size (); ++i)
+		ASSERT_EQ (
+			serial.instances[i].position.y, parallel.instances[i].position.y
+		);
+}
+
+TEST_F (ComponentsTest, ParallelPackAppendsBlocksInInstanceOrder) {
+	const glm::mat4 base_world (1.0f);
+
+	std::pmr::vector<Block> serial_blocks (3);
+	std::pmr::vector<Block> parallel_blocks (3);
+
+	serial.pack (base_world, serial_blocks);
+	parallel.pack (base_world, parallel_blocks, &task_scheduler);
+
+	ASSERT_EQ (serial_blocks.size (), 3u + serial.instances.size ());
+	ASSERT_EQ (parallel_blocks.size (), serial_blocks.size ());
+	for (size_t i = 0; i < serial_blocks.size (); ++i)
+		ASSERT_EQ (
+			0, std::memcmp (
+				   serial_blocks[i].data, parallel_blocks[i].data,
+				   sizeof (Block)
+			   )
+		);
+}
+
+TEST_F (ComponentsTest, PackInterpolatesFromPreviousInstances) {
+	serial.store_previous ();
+	for (Transform& instance : serial.instances)
+		instance.position.y += 2.0f;
+	for (Transform& instance : parallel.instances)
+		instance.position.y += 1.0f;
+
+	std::pmr::vector<Block> interpolated;
+	std::pmr::vector<Block> expected;
+
+	serial.pack (glm::mat4 (1.0f), interpolated, &task_scheduler, 0.5f);
+	parallel.pack (glm::mat4 (1.0f), expected);
+
+	ASSERT_EQ (interpolated.size (), expected.size ());
+	for (size_t i = 0; i < expected.size (); ++i)
+		ASSERT_EQ (
+			0, std::memcmp (
+				   interpolated[i].data, expected[i].data, sizeof (Block)
+			   )
+		);
+}
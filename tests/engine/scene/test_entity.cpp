@@ -144,3 +144,37 @@ TEST_F (EntityTest, ChildUpdateDoesNotMutateParentWorldMatrix) {
 	EXPECT_FLOAT_EQ (parent_before.y, parent_after.y);
 	EXPECT_FLOAT_EQ (parent_before.z, parent_after.z);
 }
+
+TEST_F (EntityTest, InterpolatedWorldMatrixBlendsPreviousAndCurrent) {
+	parent->transform.position = {0, 0, 0};
+	child->transform.position = {2, 0, 0};
+	child->set_parent (parent.get ());
+
+	parent->store_previous_transform ();
+	child->store_previous_transform ();
+
+	parent->transform.position = {10, 0, 0};
+	child->transform.position = {4, 0, 0};
+	parent->update_world_transform ();
+
+	const glm::vec3 halfway
+		= extract_translation (child->interpolated_world_matrix (0.5f));
+	EXPECT_FLOAT_EQ (halfway.x, 8.0f);
+
+	const glm::vec3 current
+		= extract_translation (child->interpolated_world_matrix (1.0f));
+	EXPECT_FLOAT_EQ (current.x, 14.0f);
+}
+
+TEST (TransformTest, InterpolateTakesShortestRotation) {
+	Transform from;
+	Transform to;
+	from.rotation = {350.0f, 0.0f, -170.0f};
+	to.rotation = {10.0f, 90.0f, 170.0f};
+
+	const Transform halfway = Transform::interpolate (from, to, 0.5f);
+
+	EXPECT_NEAR (halfway.rotation.x, 360.0f, 1e-4f);
+	EXPECT_NEAR (halfway.rotation.y, 45.0f, 1e-4f);
+	EXPECT_NEAR (halfway.rotation.z, -180.0f, 1e-4f);
+}
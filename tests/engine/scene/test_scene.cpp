@@ -1,9 +1,16 @@
+#include "entity/components/prefabs/instancing.h"
+#include "entity/components/prefabs/wave.h"
 #include "entity/entity.h"
 #include "render/render.h"
+#include "runtime/tasks/tasks.h"
 #include "scene.h"
 
+#include <array>
+#include <cmath>
+#include <future>
 #include <glm/glm.hpp>
 #include <gtest/gtest.h>
+#include <thread>
 
 static glm::vec3 world_pos (const IEntity& entity) {
 	return glm::vec3 (entity.world_matrix[3]);
@@ -127,3 +134,274 @@ TEST_F (SceneTest, CollectDrawablesCreatesDrawablePerEntity) {
 
 	EXPECT_EQ (render_state.drawables.size (), 3);
 }
+
+TEST_F (SceneTest, UnloadCancelsAndWaitsOnlyForSceneJobs) {
+	TaskScheduler task_scheduler (2);
+	task_scheduler.start ();
+	scene.task_scheduler = &task_scheduler;
+	scene.on_load ();
+
+	std::promise<void> release;
+	std::shared_future<void> released = release.get_future ().share ();
+	task_scheduler.submit ([released] { released.wait (); });
+
+	std::atomic<bool> started{false};
+	std::atomic<bool> stopped_early{false};
+	task_scheduler.submit (
+		[this, &started, &stopped_early] {
+			started = true;
+			while (!scene.task_group.cancelled ())
+				std::this_thread::yield ();
+			stopped_early = true;
+		},
+		scene.task_group
+	);
+	while (!started)
+		std::this_thread::yield ();
+
+	scene.on_unload ();
+	EXPECT_TRUE (stopped_early);
+	EXPECT_TRUE (scene.task_group.done ());
+	EXPECT_GT (task_scheduler.busy_tasks, 0);
+
+	release.set_value ();
+	task_scheduler.wait_idle ();
+	task_scheduler.stop ();
+}
+
+namespace {
+struct Tag final : IEntityComponent {
+	explicit Tag (const int value) : value (value) {}
+	int value;
+};
+} // namespace
+
+TEST_F (SceneTest, CollectsEntityViewDepthFirst) {
+	const char* names[] = {"root", "child", "grandchild", "other"};
+	IEntity* entities[4];
+	for (int i = 0; i < 4; ++i) {
+		auto entity = std::make_unique<TestEntity> (names[i]);
+		entities[i] = entity.get ();
+		scene.add_entity (std::move (entity));
+	}
+	entities[1]->set_parent (entities[0]);
+	entities[2]->set_parent (entities[1]);
+	entities[2]->transform.position = glm::vec3 (1.0f, 2.0f, 3.0f);
+
+	RenderState render_state;
+	EXPECT_EQ (render_state.scene, nullptr);
+	scene.collect_entities (render_state);
+
+	const std::pmr::vector<EntityView>& views = render_state.entities;
+	ASSERT_EQ (views.size (), 4u);
+	const size_t root = views[0].entity == entities[0] ? 0 : 1;
+	EXPECT_EQ (views[root].subtree_size, 3u);
+	EXPECT_EQ (views[root + 1].entity, entities[1]);
+	EXPECT_EQ (views[root + 1].subtree_size, 2u);
+	EXPECT_EQ (views[root + 2].name, "grandchild");
+	EXPECT_EQ (views[root + 2].transform.position, glm::vec3 (1, 2, 3));
+	EXPECT_EQ (views[root == 0 ? 3 : 0].subtree_size, 1u);
+
+	render_state.begin_frame ();
+	EXPECT_TRUE (render_state.entities.empty ());
+}
+
+TEST_F (SceneTest, CommandsRecordedByJobsAreAppliedInOneBatch) {
+	TaskScheduler task_scheduler (4);
+	task_scheduler.start ();
+
+	constexpr size_t count = 1000;
+	task_scheduler.parallel_for (0, count, 16, [this] (size_t b, size_t e) {
+		for (size_t i = b; i < e; ++i) {
+			const std::string name = "spawned_" + std::to_string (i);
+			scene.commands.add_component<Tag> (name, static_cast<int> (i));
+			scene.commands.spawn (std::make_unique<TestEntity> (name));
+		}
+	});
+	task_scheduler.stop ();
+
+	const SceneCommandStats stats = scene.apply_commands ();
+	EXPECT_EQ (stats.spawned, count);
+	EXPECT_EQ (stats.components_added, count);
+	EXPECT_EQ (stats.rejected, 0u);
+	ASSERT_EQ (scene.scene_entities.size (), count);
+	EXPECT_EQ (
+		scene.scene_entities["spawned_7"]->get_component<Tag> ()->value, 7
+	);
+}
+
+TEST_F (SceneTest, CommandsApplyByKindAndRejectInvalidChanges) {
+	scene.commands.reparent ("child", "parent");
+	scene.commands.spawn (std::make_unique<TestEntity> ("child"));
+	scene.commands.spawn (std::make_unique<TestEntity> ("parent"));
+	scene.commands.spawn (std::make_unique<TestEntity> ("parent"));
+	scene.commands.reparent ("parent", "child");
+	scene.commands.remove_component<Tag> ("child");
+
+	SceneCommandStats stats = scene.apply_commands ();
+	EXPECT_EQ (stats.spawned, 2u);
+	EXPECT_EQ (stats.reparented, 1u);
+	EXPECT_EQ (stats.rejected, 3u);
+
+	IEntity* parent = scene.scene_entities["parent"].get ();
+	IEntity* child = scene.scene_entities["child"].get ();
+	EXPECT_EQ (child->parent, parent);
+	EXPECT_EQ (parent->parent, nullptr);
+
+	scene.commands.destroy ("parent");
+	stats = scene.apply_commands ();
+	EXPECT_EQ (stats.destroyed, 1u);
+	EXPECT_FALSE (scene.scene_entities.contains ("parent"));
+	EXPECT_EQ (child->parent, nullptr);
+}
+
+TEST_F (SceneTest, ApplyingCommandsWaitsForSceneJobs) {
+	TaskScheduler task_scheduler (2);
+	task_scheduler.start ();
+	scene.task_scheduler = &task_scheduler;
+	scene.on_load ();
+
+	auto entity = std::make_unique<TestEntity> ("target");
+	TestEntity* target = entity.get ();
+	scene.add_entity (std::move (entity));
+
+	std::promise<void> release;
+	std::shared_future<void> released = release.get_future ().share ();
+	std::atomic<bool> started{false};
+	std::atomic<bool> finished{false};
+	task_scheduler.submit (
+		[target, released, &started, &finished] {
+			started = true;
+			released.wait ();
+			target->updated = true;
+			finished = true;
+		},
+		scene.task_group
+	);
+	while (!started)
+		std::this_thread::yield ();
+
+	// The job outlives the step that recorded the destroy.
+	scene.commands.destroy ("target");
+	std::thread releaser ([&release] {
+		std::this_thread::sleep_for (std::chrono::milliseconds (10));
+		release.set_value ();
+	});
+
+	const SceneCommandStats stats = scene.apply_commands ();
+	EXPECT_TRUE (finished);
+	EXPECT_EQ (stats.destroyed, 1u);
+	EXPECT_FALSE (scene.scene_entities.contains ("target"));
+
+	releaser.join ();
+	task_scheduler.stop ();
+}
+
+TEST_F (SceneTest, CommandBuffersStayOnePerThreadPastTheCache) {
+	std::array<SceneCommands, 6> commands;
+	for (int round = 0; round < 3; ++round)
+		for (SceneCommands& scene_commands : commands)
+			scene_commands.destroy ("missing");
+
+	for (SceneCommands& scene_commands : commands) {
+		EXPECT_EQ (scene_commands.buffer_count (), 1u);
+		EXPECT_EQ (scene_commands.apply (scene).rejected, 3u);
+	}
+}
+
+TEST (SceneSystemsTest, SystemsShareWavesUnlessTheyConflict) {
+	SceneSystems systems;
+	auto noop = [] (Scene&, float, float) {};
+	systems.add ("read", SystemAccess{}.read<Tag> (), noop);
+	systems.add ("other", SystemAccess{}.write<Transform> (), noop);
+	systems.add ("write", SystemAccess{}.write<Tag> (), noop);
+	systems.add ("read again", SystemAccess{}.read<Tag> (), noop);
+	systems.add ("all", SystemAccess{.exclusive = true}, noop);
+
+	const auto& waves = systems.get_waves ();
+	ASSERT_EQ (waves.size (), 4);
+	EXPECT_EQ (waves[0], (std::vector<size_t>{0, 1}));
+	EXPECT_EQ (waves[1], (std::vector<size_t>{2}));
+	EXPECT_EQ (waves[2], (std::vector<size_t>{3}));
+	EXPECT_EQ (waves[3], (std::vector<size_t>{4}));
+}
+
+TEST_F (SceneTest, SystemsRunInWavesOnTheScheduler) {
+	TaskScheduler task_scheduler (2);
+	task_scheduler.start ();
+	scene.task_scheduler = &task_scheduler;
+
+	const size_t builtin = scene.systems.size ();
+	std::atomic<int> first_wave{0};
+	int seen_by_second = -1;
+	for (int i = 0; i < 4; ++i)
+		scene.systems.add (
+			"reader", SystemAccess{}.read<Tag> (),
+			[&first_wave] (Scene&, float, float) { ++first_wave; }
+		);
+	scene.systems.add (
+		"writer", SystemAccess{}.write<Tag> (),
+		[&] (Scene&, float, float) { seen_by_second = first_wave; }
+	);
+
+	scene.update (16.0f, 0.0f);
+	EXPECT_EQ (seen_by_second, 4);
+
+	std::vector<SystemRun> runs;
+	scene.systems.copy_last_run (runs);
+	ASSERT_EQ (runs.size (), builtin + 5);
+	EXPECT_EQ (runs.back ().system, builtin + 4);
+	EXPECT_EQ (runs.back ().wave, runs[builtin].wave + 1);
+	for (const SystemRun& run : runs)
+		EXPECT_LE (run.start_ms, run.end_ms);
+
+	task_scheduler.stop ();
+}
+
+TEST_F (SceneTest, UpdateRunsBuiltinSystemsInConflictWaves) {
+	TaskScheduler task_scheduler (2);
+	task_scheduler.start ();
+	scene.task_scheduler = &task_scheduler;
+
+	auto entity = std::make_unique<TestEntity> ("grid");
+	TestEntity* grid = entity.get ();
+	auto& instancing = grid->add_component<InstancingComponent> ();
+	instancing.instances.resize (4096);
+	grid->add_component<WaveComponent> (glm::vec3 (0.0f), 0.0f);
+	scene.add_entity (std::move (entity));
+
+	ASSERT_EQ (scene.systems.size (), 4u);
+	std::atomic<int> tag_readers{0};
+	scene.systems.add (
+		"tag", SystemAccess{}.read<Tag> (),
+		[&tag_readers] (Scene&, float, float) { ++tag_readers; }
+	);
+	scene.systems.add (
+		"after_wave", SystemAccess{}.read<InstancingComponent> (),
+		[] (Scene&, float, float) {}
+	);
+
+	scene.update (16.0f, 1000.0f);
+	EXPECT_TRUE (grid->updated);
+	EXPECT_EQ (tag_readers, 1);
+	EXPECT_FLOAT_EQ (
+		instancing.instances[0].position.y, std::sin (-1.0f) * 2.0f
+	);
+
+	scene.update (16.0f, 2000.0f);
+	EXPECT_FLOAT_EQ (
+		instancing.previous_instances[0].position.y, std::sin (-1.0f) * 2.0f
+	);
+
+	// History shares the first wave, entity updates run alone, the wave
+	// system shares its wave with the unrelated reader and anything that
+	// reads instances waits for it.
+	std::vector<SystemRun> runs;
+	scene.systems.copy_last_run (runs);
+	std::vector<size_t> wave_of (scene.systems.size ());
+	for (const SystemRun& run : runs)
+		wave_of[run.system] = run.wave;
+	EXPECT_EQ (wave_of, (std::vector<size_t>{0, 0, 1, 2, 2, 3}));
+
+	task_scheduler.stop ();
+}
@@ -0,0 +1,273 @@
+#include "engine/core/memory/allocations.h"
+#include "engine/render/snapshot.h"
+#include "engine/runtime/tasks/tasks.h"
+
+#include <array>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <new>
+
+namespace {
+thread_local size_t thread_allocations = 0;
+
+void* counted_allocate (const size_t size) {
+	++thread_allocations;
+	if (void* memory = std::malloc (size ? size : 1))
+		return memory;
+	throw std::bad_alloc ();
+}
+
+void* counted_allocate (const size_t size, const std::align_val_t alignment) {
+	++thread_allocations;
+	if (void* memory = aligned_malloc (
+			size, static_cast<size_t> (alignment)
+		))
+		return memory;
+	throw std::bad_alloc ();
+}
+} // namespace
+
+void* operator new (const size_t size) { return counted_allocate (size); }
+void* operator new[] (const size_t size) { return counted_allocate (size); }
+void* operator new (const size_t size, const std::align_val_t alignment) {
+	return counted_allocate (size, alignment);
+}
+void* operator new[] (const size_t size, const std::align_val_t alignment) {
+	return counted_allocate (size, alignment);
+}
+void* operator new (const size_t size, const std::nothrow_t&) noexcept {
+	++thread_allocations;
+	return std::malloc (size ? size : 1);
+}
+void* operator new[] (const size_t size, const std::nothrow_t&) noexcept {
+	++thread_allocations;
+	return std::malloc (size ? size : 1);
+}
+
+void operator delete (void* memory) noexcept { std::free (memory); }
+void operator delete[] (void* memory) noexcept { std::free (memory); }
+void operator delete (void* memory, size_t) noexcept { std::free (memory); }
+void operator delete[] (void* memory, size_t) noexcept { std::free (memory); }
+void operator delete (void* memory, const std::nothrow_t&) noexcept {
+	std::free (memory);
+}
+void operator delete[] (void* memory, const std::nothrow_t&) noexcept {
+	std::free (memory);
+}
+void operator delete (void* memory, std::align_val_t) noexcept {
+	aligned_free (memory);
+}
+void operator delete[] (void* memory, std::align_val_t) noexcept {
+	aligned_free (memory);
+}
+void operator delete (void* memory, size_t, std::align_val_t) noexcept {
+	aligned_free (memory);
+}
+void operator delete[] (void* memory, size_t, std::align_val_t) noexcept {
+	aligned_free (memory);
+}
+
+class AllocationsTest : public ::testing::Test {
+  protected:
+	void SetUp () override { task_scheduler.start (); }
+	void TearDown () override { task_scheduler.stop (); }
+
+	TaskScheduler task_scheduler{4};
+	std::atomic<int> completed{0};
+};
+
+TEST_F (AllocationsTest, SubmittingSmallJobsDoesNotAllocate) {
+	TaskGroup group;
+
+	const size_t before = thread_allocations;
+	for (int i = 0; i < 1000; ++i)
+		task_scheduler.submit ([this] { ++completed; });
+	for (int i = 0; i < 1000; ++i)
+		task_scheduler.submit ([this] { ++completed; }, group);
+	const size_t allocations = thread_allocations - before;
+
+	task_scheduler.wait_idle ();
+	EXPECT_EQ (allocations, 0u);
+	EXPECT_EQ (completed, 2000);
+	EXPECT_EQ (task_scheduler.get_stats ().task_pool_misses, 0u);
+}
+
+TEST_F (AllocationsTest, NestedSubmissionFromWorkersDoesNotAllocate) {
+	std::atomic<size_t> allocations{0};
+
+	for (int i = 0; i < 16; ++i) {
+		task_scheduler.submit ([this, &allocations] {
+			const size_t before = thread_allocations;
+			for (int j = 0; j < 64; ++j)
+				task_scheduler.submit ([this] { ++completed; });
+			allocations += thread_allocations - before;
+		});
+	}
+
+	task_scheduler.wait_idle ();
+	EXPECT_EQ (allocations, 0u);
+	EXPECT_EQ (completed, 16 * 64);
+}
+
+TEST_F (AllocationsTest, LargeCapturesUseTheFrameArena) {
+	std::array<int, 64> payload{};
+	payload.back () = 1;
+
+	const size_t before = thread_allocations;
+	for (int i = 0; i < 100; ++i)
+		task_scheduler.submit ([this, payload] { completed += payload.back (); }
+		);
+	const size_t allocations = thread_allocations - before;
+
+	task_scheduler.wait_idle ();
+	EXPECT_EQ (allocations, 0u);
+	EXPECT_EQ (completed, 100);
+
+	const TaskSchedulerStats stats = task_scheduler.get_stats ();
+	EXPECT_EQ (stats.arena_jobs, 100u);
+	EXPECT_EQ (stats.heap_jobs, 0u);
+	EXPECT_GE (stats.arena_bytes, 100 * sizeof (payload));
+
+	task_scheduler.end_frame ();
+	task_scheduler.end_frame ();
+	EXPECT_EQ (task_scheduler.get_stats ().arena_bytes, 0u);
+}
+
+TEST_F (AllocationsTest, ParallelLoopsDoNotAllocate) {
+	std::array<uint32_t, 4096> values{};
+	const auto body = [&] (size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i)
+			++values[i];
+	};
+	const auto sum = [&] (size_t begin, size_t end) {
+		uint64_t partial = 0;
+		for (size_t i = begin; i < end; ++i)
+			partial += values[i];
+		return partial;
+	};
+	const auto add = [] (uint64_t a, uint64_t b) { return a + b; };
+
+	task_scheduler.parallel_for (0, values.size (), 64, body);
+
+	const size_t before = thread_allocations;
+	task_scheduler.parallel_for (0, values.size (), 64, body);
+	const uint64_t total = task_scheduler.parallel_reduce (
+		0, values.size (), 64, uint64_t{0}, sum, add
+	);
+	const size_t allocations = thread_allocations - before;
+
+	EXPECT_EQ (allocations, 0u);
+	EXPECT_EQ (total, 2u * values.size ());
+}
+
+TEST (JobTest, KeepsSmallCapturesInline) {
+	int value = 0;
+	Job job ([&value] { ++value; });
+	EXPECT_EQ (job.get_storage (), JobStorage::Inline);
+
+	Job moved (std::move (job));
+	EXPECT_FALSE (job);
+	moved ();
+	EXPECT_EQ (value, 1);
+}
+
+TEST (JobTest, DestroysCapturesExactlyOnce) {
+	auto shared = std::make_shared<int> (0);
+	std::array<char, 128> padding{};
+	{
+		Job small ([shared] {});
+		Job large ([shared, padding] {});
+		EXPECT_EQ (large.get_storage (), JobStorage::Heap);
+		EXPECT_EQ (shared.use_count (), 3);
+
+		Job moved = std::move (large);
+		EXPECT_EQ (shared.use_count (), 3);
+	}
+	EXPECT_EQ (shared.use_count (), 1);
+}
+
+TEST (JobTest, FallsBackToHeapWhenArenaIsFull) {
+	JobArena arena (256);
+	std::array<char, 200> payload{};
+
+	Job first ([payload] {}, &arena);
+	Job second ([payload] {}, &arena);
+	EXPECT_EQ (first.get_storage (), JobStorage::Arena);
+	EXPECT_EQ (second.get_storage (), JobStorage::Heap);
+
+	arena.close ();
+	EXPECT_FALSE (arena.try_reset ());
+	first.reset ();
+	EXPECT_TRUE (arena.try_reset ());
+	EXPECT_EQ (arena.used (), 0u);
+}
+
+namespace {
+Coroutine count_on_worker (TaskScheduler& scheduler, std::atomic<int>& count) {
+	co_await scheduler.schedule ();
+	++count;
+}
+} // namespace
+
+TEST_F (AllocationsTest, SteadyStateCoroutinesDoNotAllocate) {
+	count_on_worker (task_scheduler, completed);
+	task_scheduler.wait_idle ();
+
+	const size_t before = thread_allocations;
+	for (int i = 0; i < 100; ++i) {
+		count_on_worker (task_scheduler, completed);
+		task_scheduler.wait_idle ();
+	}
+	const size_t allocations = thread_allocations - before;
+
+	EXPECT_EQ (allocations, 0u);
+	EXPECT_EQ (completed, 101);
+}
+
+TEST_F (AllocationsTest, SteadyStateSnapshotHandoffDoesNotAllocate) {
+	RenderStateBuffer buffer;
+	const auto cycle = [&buffer] {
+		RenderState& state = buffer.write_slot ();
+		state.drawables.resize (8);
+		for (Drawable& drawable : state.drawables) {
+			drawable.instance_blocks.clear ();
+			drawable.instance_blocks.resize (64);
+		}
+		buffer.publish ();
+		buffer.acquire ();
+	};
+
+	for (int i = 0; i < 3; ++i)
+		cycle ();
+
+	const size_t before = thread_allocations;
+	for (int i = 0; i < 100; ++i)
+		cycle ();
+
+	EXPECT_EQ (thread_allocations - before, 0u);
+	EXPECT_EQ (buffer.get_stats ().consumed, 103u);
+}
+
+TEST_F (AllocationsTest, SteadyStateFrameArenaDoesNotAllocate) {
+	RenderStateBuffer buffer;
+	const auto cycle = [&buffer] (const size_t drawables) {
+		RenderState& state = buffer.write_slot ();
+		state.begin_frame ();
+		state.drawables.resize (drawables);
+		for (size_t i = 0; i < drawables; ++i)
+			state.drawables[i].instance_blocks.resize (64 + i);
+		buffer.publish ();
+		buffer.acquire ();
+	};
+
+	// Each slot spills on its first frame and grows to that peak when it
+	// is begun again; after that every frame fits.
+	for (size_t i = 0; i < 6; ++i)
+		cycle (256);
+
+	const size_t before = thread_allocations;
+	for (size_t i = 0; i < 100; ++i)
+		cycle (128 + i);
+
+	EXPECT_EQ (thread_allocations - before, 0u);
+}
@@ -0,0 +1,50 @@
+#include "engine/runtime/clock.h"
+
+#include <gtest/gtest.h>
+
+TEST (ClockTest, JitterIsZeroBeforeAnyFrame) {
+	const Clock clock (60);
+	const FrameJitter jitter = clock.get_jitter ();
+
+	EXPECT_EQ (jitter.p50_ms, 0.0f);
+	EXPECT_EQ (jitter.p99_ms, 0.0f);
+}
+
+TEST (ClockTest, HybridPacingHitsTheTargetFrameTime) {
+	Clock clock (200);
+	clock.pacing = FramePacing::Hybrid;
+	clock.spin_window_ms = 2.0f;
+
+	const auto start = std::chrono::steady_clock::now ();
+	for (int i = 0; i < 20; ++i) {
+		clock.begin_frame ();
+		clock.end_frame ();
+	}
+	const float elapsed_ms = std::chrono::duration<float, std::milli> (
+								 std::chrono::steady_clock::now () - start
+	)
+								 .count ();
+
+	EXPECT_GE (elapsed_ms, 20 * 5.0f * 0.95f);
+
+	const FrameJitter jitter = clock.get_jitter ();
+	EXPECT_LE (jitter.p50_ms, jitter.p95_ms);
+	EXPECT_LE (jitter.p95_ms, jitter.p99_ms);
+	EXPECT_LT (jitter.p50_ms, 1.0f);
+}
+
+TEST (ClockTest, SlowFramesShowUpInUpperPercentiles) {
+	Clock clock (1000);
+	clock.pacing = FramePacing::Spin;
+
+	for (int i = 0; i < 100; ++i) {
+		clock.begin_frame ();
+		if (i % 10 == 0)
+			std::this_thread::sleep_for (std::chrono::milliseconds (5));
+		clock.end_frame ();
+	}
+
+	const FrameJitter jitter = clock.get_jitter ();
+	EXPECT_LT (jitter.p50_ms, 0.5f);
+	EXPECT_GT (jitter.p99_ms, 3.0f);
+}
@@ -0,0 +1,123 @@
+#include "engine/runtime/tasks/tasks.h"
+
+#include <gtest/gtest.h>
+#include <thread>
+
+class CoroutinesTest : public ::testing::Test {
+  protected:
+	void SetUp () override { task_scheduler.start (); }
+	void TearDown () override { task_scheduler.stop (); }
+
+	TaskScheduler task_scheduler{4};
+};
+
+namespace {
+Coroutine hop_to_worker (TaskScheduler& scheduler, bool& on_worker) {
+	co_await scheduler.schedule ();
+	on_worker = scheduler.on_worker_thread ();
+}
+
+Coroutine await_job (TaskScheduler& scheduler, int& value) {
+	const JobHandle job = scheduler.schedule ([&value] { value = 1; });
+	co_await job;
+	value *= 10;
+}
+
+Coroutine await_all (TaskScheduler& scheduler, std::atomic<int>& value) {
+	const JobHandle first = scheduler.schedule ([&value] { value += 1; });
+	const JobHandle second = scheduler.schedule ([&value] { value += 2; });
+	const JobHandle third = scheduler.schedule ([&value] { value += 4; });
+	co_await when_all (first, second, third);
+	value = value * 10;
+}
+
+Coroutine wait_frames (TaskScheduler& scheduler, int& frames) {
+	for (int i = 0; i < 2; ++i) {
+		co_await scheduler.next_frame ();
+		++frames;
+	}
+}
+
+Coroutine stage (TaskScheduler& scheduler, std::vector<int>& order, int id) {
+	co_await scheduler.schedule ();
+	order.push_back (id);
+}
+
+Coroutine pipeline (TaskScheduler& scheduler, std::vector<int>& order) {
+	co_await stage (scheduler, order, 1);
+	co_await stage (scheduler, order, 2);
+	order.push_back (3);
+}
+} // namespace
+
+TEST_F (CoroutinesTest, ScheduleResumesOnWorkerThread) {
+	bool on_worker = false;
+	const Coroutine coroutine = hop_to_worker (task_scheduler, on_worker);
+
+	task_scheduler.wait_idle ();
+	EXPECT_TRUE (coroutine.done ());
+	EXPECT_TRUE (on_worker);
+}
+
+TEST_F (CoroutinesTest, AwaitingJobResumesAfterItFinishes) {
+	int value = 0;
+	const Coroutine coroutine = await_job (task_scheduler, value);
+
+	task_scheduler.wait_idle ();
+	EXPECT_TRUE (coroutine.done ());
+	EXPECT_EQ (value, 10);
+}
+
+TEST_F (CoroutinesTest, WhenAllWaitsForEveryJob) {
+	for (int i = 0; i < 100; ++i) {
+		std::atomic<int> value{0};
+		const Coroutine coroutine = await_all (task_scheduler, value);
+
+		task_scheduler.wait_idle ();
+		ASSERT_TRUE (coroutine.done ());
+		ASSERT_EQ (value, 70);
+	}
+}
+
+TEST_F (CoroutinesTest, NextFrameResumesAfterEndFrame) {
+	int frames = 0;
+	const Coroutine coroutine = wait_frames (task_scheduler, frames);
+
+	task_scheduler.wait_idle ();
+	EXPECT_EQ (frames, 0);
+
+	task_scheduler.end_frame ();
+	task_scheduler.wait_idle ();
+	EXPECT_EQ (frames, 1);
+	EXPECT_FALSE (coroutine.done ());
+
+	task_scheduler.end_frame ();
+	task_scheduler.wait_idle ();
+	EXPECT_EQ (frames, 2);
+	EXPECT_TRUE (coroutine.done ());
+}
+
+TEST_F (CoroutinesTest, AwaitingCoroutinesRunsStagesInOrder) {
+	std::vector<int> order;
+	const Coroutine coroutine = pipeline (task_scheduler, order);
+
+	while (!coroutine.done ())
+		std::this_thread::yield ();
+	EXPECT_EQ (order, (std::vector<int>{1, 2, 3}));
+}
+
+TEST_F (CoroutinesTest, DetachedCoroutinesReturnFramesToThePool) {
+	bool on_worker = false;
+	hop_to_worker (task_scheduler, on_worker);
+	task_scheduler.wait_idle ();
+
+	const CoroutineFrameStats before = get_coroutine_frame_stats ();
+	for (int i = 0; i < 10; ++i) {
+		hop_to_worker (task_scheduler, on_worker);
+		task_scheduler.wait_idle ();
+	}
+	const CoroutineFrameStats after = get_coroutine_frame_stats ();
+
+	EXPECT_EQ (after.allocated, before.allocated);
+	EXPECT_EQ (after.reused - before.reused, 10u);
+}
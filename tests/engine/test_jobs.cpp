@@ -0,0 +1,236 @@
+#include "engine/runtime/tasks/tasks.h"
+
+#include <chrono>
+#include <future>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST (JobTest, InvokingAnEmptyJobDoesNothing) {
+	Job empty;
+	EXPECT_FALSE (empty);
+	empty ();
+
+	int value = 0;
+	Job job ([&value] { ++value; });
+	Job moved (std::move (job));
+	job ();
+	EXPECT_EQ (value, 0);
+
+	moved ();
+	EXPECT_EQ (value, 1);
+}
+
+class JobsTest : public ::testing::Test {
+  protected:
+	void SetUp () override { task_scheduler.start (); }
+	void TearDown () override { task_scheduler.stop (); }
+
+	void record (const std::string& step) {
+		std::lock_guard lock (order_mutex);
+		order.push_back (step);
+	}
+
+	TaskScheduler task_scheduler{4};
+
+	std::mutex order_mutex;
+	std::vector<std::string> order;
+};
+
+TEST_F (JobsTest, ScheduledJobRunsAfterItsDependency) {
+	const JobHandle update = task_scheduler.schedule ([&] {
+		std::this_thread::sleep_for (std::chrono::milliseconds (10));
+		record ("update");
+	});
+	const JobHandle pack = task_scheduler.schedule (
+		[&] { record ("pack"); }, {update}
+	);
+
+	task_scheduler.wait (pack);
+
+	EXPECT_TRUE (update.done ());
+	EXPECT_TRUE (pack.done ());
+	ASSERT_EQ (order.size (), 2u);
+	EXPECT_EQ (order[0], "update");
+	EXPECT_EQ (order[1], "pack");
+}
+
+TEST_F (JobsTest, ThenChainsContinuations) {
+	const JobHandle update = task_scheduler.schedule ([&] {
+		record ("update");
+	});
+	const JobHandle pack = update.then ([&] { record ("pack"); });
+	const JobHandle upload = pack.then ([&] { record ("upload"); });
+
+	task_scheduler.wait (upload);
+
+	const std::vector<std::string> expected{"update", "pack", "upload"};
+	EXPECT_EQ (order, expected);
+}
+
+TEST_F (JobsTest, DiamondJoinWaitsForAllDependencies) {
+	std::atomic<int> finished_branches{0};
+	std::atomic<int> seen_at_join{-1};
+
+	const JobHandle root = task_scheduler.schedule ([] {});
+	const JobHandle left = task_scheduler.schedule (
+		[&] { ++finished_branches; }, {root}
+	);
+	const JobHandle right = task_scheduler.schedule (
+		[&] {
+			std::this_thread::sleep_for (std::chrono::milliseconds (5));
+			++finished_branches;
+		},
+		{root}
+	);
+	const JobHandle join = task_scheduler.schedule (
+		[&] { seen_at_join = finished_branches.load (); }, {left, right}
+	);
+
+	task_scheduler.wait (join);
+	EXPECT_EQ (seen_at_join, 2);
+}
+
+TEST_F (JobsTest, DependencyOnFinishedJobDoesNotBlock) {
+	const JobHandle first = task_scheduler.schedule ([] {});
+	task_scheduler.wait (first);
+
+	std::atomic<bool> ran{false};
+	const JobHandle second = task_scheduler.schedule (
+		[&] { ran = true; }, {first, JobHandle{}}
+	);
+	task_scheduler.wait (second);
+
+	EXPECT_TRUE (ran);
+}
+
+TEST_F (JobsTest, WaitOnGroupIgnoresJobsOutsideTheGroup) {
+	std::promise<void> release;
+	std::shared_future<void> released = release.get_future ().share ();
+	task_scheduler.submit ([released] { released.wait (); });
+
+	TaskGroup group;
+	std::atomic<int> completed{0};
+	for (int i = 0; i < 64; ++i)
+		task_scheduler.submit ([&] { ++completed; }, group);
+
+	const JobHandle graph_job = task_scheduler.schedule (
+		[&] { ++completed; }, {}, &group
+	);
+
+	task_scheduler.wait (group);
+	EXPECT_TRUE (group.done ());
+	EXPECT_TRUE (graph_job.done ());
+	EXPECT_EQ (completed, 65);
+	EXPECT_GT (task_scheduler.busy_tasks, 0);
+
+	release.set_value ();
+	task_scheduler.wait_idle ();
+}
+
+TEST_F (JobsTest, GroupCountsJobsStillWaitingOnDependencies) {
+	std::promise<void> release;
+	std::shared_future<void> released = release.get_future ().share ();
+
+	TaskGroup group;
+	const JobHandle gate = task_scheduler.schedule ([released] {
+		released.wait ();
+	});
+	task_scheduler.schedule ([] {}, {gate}, &group);
+
+	EXPECT_EQ (group.pending_count (), 1);
+	EXPECT_FALSE (group.done ());
+
+	release.set_value ();
+	task_scheduler.wait (group);
+	EXPECT_TRUE (group.done ());
+}
+
+TEST (JobsCancelTest, CancelledGroupDropsJobsThatHaveNotStarted) {
+	TaskScheduler task_scheduler (1);
+	task_scheduler.start ();
+
+	std::promise<void> release;
+	std::shared_future<void> released = release.get_future ().share ();
+	std::atomic<bool> blocked{false};
+	task_scheduler.submit ([&blocked, released] {
+		blocked = true;
+		released.wait ();
+	});
+	while (!blocked)
+		std::this_thread::yield ();
+
+	TaskGroup group;
+	std::atomic<int> ran{0};
+	for (int i = 0; i < 100; ++i)
+		task_scheduler.submit ([&ran] { ++ran; }, group);
+	task_scheduler.schedule ([&ran] { ++ran; }, {}, &group);
+
+	group.cancel ();
+	task_scheduler.submit ([&ran] { ++ran; }, group);
+	EXPECT_EQ (group.pending_count (), 101);
+
+	release.set_value ();
+	task_scheduler.wait (group);
+	EXPECT_EQ (ran, 0);
+	EXPECT_EQ (task_scheduler.get_stats ().dropped, 102u);
+
+	group.reset ();
+	task_scheduler.submit ([&ran] { ++ran; }, group);
+	task_scheduler.wait (group);
+	EXPECT_EQ (ran, 1);
+	task_scheduler.stop ();
+}
+
+TEST (JobsCancelTest, NothingIsAddedAfterCancelledGroupDrains) {
+	TaskScheduler task_scheduler (2);
+	task_scheduler.start ();
+
+	TaskGroup group;
+	std::atomic<int> ran{0};
+	std::atomic<bool> stop{false};
+	std::thread submitter ([&] {
+		while (!stop)
+			task_scheduler.submit ([&ran] { ++ran; }, group);
+	});
+	while (ran == 0)
+		std::this_thread::yield ();
+
+	group.cancel ();
+	task_scheduler.wait (group);
+	const int drained = ran;
+	EXPECT_TRUE (group.done ());
+
+	std::this_thread::sleep_for (std::chrono::milliseconds (5));
+	EXPECT_TRUE (group.done ());
+	EXPECT_EQ (ran, drained);
+
+	stop = true;
+	submitter.join ();
+	group.reset ();
+	task_scheduler.stop ();
+}
+
+TEST (JobsWaitTest, WaitingInsideAJobHelpsInsteadOfBlocking) {
+	TaskScheduler task_scheduler (1);
+	task_scheduler.start ();
+
+	std::atomic<int> completed{0};
+	TaskGroup outer;
+	task_scheduler.submit (
+		[&] {
+			TaskGroup inner;
+			for (int i = 0; i < 16; ++i)
+				task_scheduler.submit ([&] { ++completed; }, inner);
+			task_scheduler.wait (inner);
+			EXPECT_EQ (completed, 16);
+		},
+		outer
+	);
+
+	task_scheduler.wait (outer);
+	EXPECT_EQ (completed, 16);
+	task_scheduler.stop ();
+}
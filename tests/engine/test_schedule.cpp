@@ -0,0 +1,180 @@
+#include "engine/runtime/schedule/incremental.h"
+#include "engine/runtime/schedule/systems.h"
+#include "engine/runtime/tasks/tasks.h"
+
+#include <chrono>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+class ScheduleTest : public ::testing::Test {
+  protected:
+	Schedule make (const CatchUp catch_up, const float budget_ms = 0.0f) {
+		SystemConfig config;
+		config.interval_ms = 10.0f;
+		config.catch_up = catch_up;
+		config.max_substeps = 3;
+		config.budget_ms = budget_ms;
+		return Schedule (config, [this] (const float dt) {
+			steps.push_back (dt);
+		});
+	}
+
+	std::vector<float> steps;
+};
+
+TEST_F (ScheduleTest, SubstepRunsFixedTicksAndDropsTheExcess) {
+	Schedule schedule = make (CatchUp::Substep);
+
+	EXPECT_EQ (schedule.advance (45.0f), 3);
+	schedule.run ();
+	EXPECT_EQ (steps, (std::vector<float>{10.0f, 10.0f, 10.0f}));
+	EXPECT_EQ (schedule.get_stats ().dropped_ticks, 1u);
+
+	// The fractional remainder carries over to the next frame.
+	EXPECT_EQ (schedule.advance (5.0f), 1);
+	EXPECT_EQ (schedule.advance (0.0f), 0);
+}
+
+TEST_F (ScheduleTest, ClampRunsOneBoundedTick) {
+	Schedule schedule = make (CatchUp::Clamp);
+
+	EXPECT_EQ (schedule.advance (45.0f), 1);
+	schedule.run ();
+	EXPECT_EQ (steps, (std::vector<float>{30.0f}));
+	EXPECT_EQ (schedule.get_stats ().dropped_ticks, 1u);
+}
+
+TEST_F (ScheduleTest, DropRunsOneTickPerFrame) {
+	Schedule schedule = make (CatchUp::Drop);
+
+	EXPECT_EQ (schedule.advance (45.0f), 1);
+	schedule.run ();
+	EXPECT_EQ (steps, (std::vector<float>{10.0f}));
+	EXPECT_EQ (schedule.get_stats ().dropped_ticks, 3u);
+}
+
+TEST_F (ScheduleTest, OverBudgetTickDropsRemainingSubsteps) {
+	SystemConfig config;
+	config.interval_ms = 10.0f;
+	config.max_substeps = 3;
+	config.budget_ms = 0.5f;
+	Schedule schedule (config, [] (float) {
+		std::this_thread::sleep_for (std::chrono::milliseconds (2));
+	});
+
+	schedule.advance (30.0f);
+	schedule.run ();
+
+	const ScheduleStats& stats = schedule.get_stats ();
+	EXPECT_EQ (stats.ticks, 1u);
+	EXPECT_EQ (stats.over_budget_ticks, 1u);
+	EXPECT_EQ (stats.dropped_ticks, 2u);
+	EXPECT_GT (stats.last_tick_ms, config.budget_ms);
+}
+
+TEST_F (ScheduleTest, SystemsRunAtTheirOwnRatesAndJoin) {
+	TaskScheduler task_scheduler (4);
+	task_scheduler.start ();
+
+	std::atomic<int> fast{0};
+	std::atomic<int> slow{0};
+
+	SystemScheduler systems;
+	systems.add ({5.0f, CatchUp::Substep, 8, 0.0f}, [&] (float) { ++fast; });
+	systems.add ({20.0f, CatchUp::Substep, 8, 0.0f}, [&] (float) { ++slow; });
+
+	for (int frame = 0; frame < 4; ++frame)
+		systems.update (10.0f, task_scheduler);
+	systems.join (task_scheduler);
+
+	EXPECT_EQ (fast, 8);
+	EXPECT_EQ (slow, 2);
+	EXPECT_EQ (systems.get (0).get_stats ().ticks, 8u);
+
+	task_scheduler.stop ();
+}
+
+TEST (IncrementalJobsTest, RunsSlicesUntilFinished) {
+	IncrementalJobs jobs;
+	int units = 0;
+	const uint64_t id = jobs.add ([&units] (const SliceBudget&) {
+		return static_cast<float> (++units) / 4.0f;
+	});
+	EXPECT_EQ (jobs.progress (id), 0.0f);
+
+	jobs.run (0.0f);
+	EXPECT_EQ (units, 0);
+
+	for (int frame = 0; frame < 3; ++frame)
+		jobs.run (5.0f);
+	EXPECT_EQ (units, 3);
+	EXPECT_FLOAT_EQ (jobs.progress (id), 0.75f);
+
+	jobs.run (5.0f);
+	EXPECT_EQ (jobs.size (), 0u);
+	EXPECT_EQ (jobs.progress (id), 1.0f);
+	EXPECT_EQ (jobs.get_stats ().completed, 1u);
+}
+
+namespace {
+std::chrono::steady_clock::time_point manual_time;
+std::chrono::steady_clock::time_point manual_now () { return manual_time; }
+} // namespace
+
+TEST (IncrementalJobsTest, SharesBudgetBetweenJobs) {
+	IncrementalJobs jobs (manual_now);
+	std::vector<int> order;
+	std::vector<int> units (3, 0);
+	for (int i = 0; i < 3; ++i)
+		jobs.add ([i, &order, &units] (const SliceBudget& budget) {
+			order.push_back (i);
+			while (!budget.expired ()) {
+				manual_time += std::chrono::microseconds (500);
+				++units[i];
+			}
+			return 0.0f;
+		});
+
+	// A 3 ms frame splits into 1 ms per job, two 0.5 ms units each.
+	jobs.run (3.0f);
+	EXPECT_EQ (order, (std::vector<int>{0, 1, 2}));
+	EXPECT_EQ (units, (std::vector<int>{2, 2, 2}));
+	EXPECT_EQ (jobs.get_stats ().slices, 3u);
+	EXPECT_FLOAT_EQ (jobs.get_stats ().last_used_ms, 3.0f);
+	EXPECT_EQ (jobs.get_stats ().over_budget_frames, 0u);
+}
+
+TEST (IncrementalJobsTest, FinishedJobLeavesItsShareToTheRest) {
+	IncrementalJobs jobs (manual_now);
+	std::vector<int> units (3, 0);
+	jobs.add ([] (const SliceBudget&) { return 1.0f; });
+	for (int i = 1; i < 3; ++i)
+		jobs.add ([i, &units] (const SliceBudget& budget) {
+			while (!budget.expired ()) {
+				manual_time += std::chrono::microseconds (500);
+				++units[i];
+			}
+			return 0.0f;
+		});
+
+	jobs.run (3.0f);
+	EXPECT_EQ (units, (std::vector<int>{0, 3, 3}));
+	EXPECT_EQ (jobs.get_stats ().completed, 1u);
+}
+
+TEST (IncrementalJobsTest, NextFrameResumesAfterLastSlicedJob) {
+	IncrementalJobs jobs;
+	std::vector<int> order;
+	for (int i = 0; i < 3; ++i)
+		jobs.add ([i, &order] (const SliceBudget&) {
+			order.push_back (i);
+			std::this_thread::sleep_for (std::chrono::milliseconds (2));
+			return 0.0f;
+		});
+
+	jobs.run (1.0f);
+	jobs.run (1.0f);
+	EXPECT_EQ (order, (std::vector<int>{0, 1}));
+	EXPECT_EQ (jobs.get_stats ().over_budget_frames, 2u);
+}
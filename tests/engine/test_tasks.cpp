@@ -1,8 +1,16 @@
 #include "engine/runtime/tasks/tasks.h"
 
+#include <functional>
 #include <future>
 #include <gtest/gtest.h>
+#include <string>
 #include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 class TasksTest : public ::testing::Test {
   protected:
@@ -47,3 +55,455 @@ TEST_F (TasksTest, JoinsThreadsOnStop) {
 	task_scheduler.stop ();
 	ASSERT_FALSE (task_scheduler.running);
 }
+
+TEST_F (TasksTest, RunsEveryJobSubmittedFromOutsideWorkers) {
+	TaskScheduler task_scheduler;
+	task_scheduler.start ();
+
+	constexpr int job_count = 2000;
+	std::atomic<int> completed{0};
+
+	for (int i = 0; i < job_count; ++i)
+		task_scheduler.submit ([&] { ++completed; });
+
+	task_scheduler.wait_idle ();
+	EXPECT_EQ (completed, job_count);
+
+	const TaskSchedulerStats stats = task_scheduler.get_stats ();
+	EXPECT_EQ (stats.injected, static_cast<uint64_t> (job_count));
+	EXPECT_EQ (stats.executed, static_cast<uint64_t> (job_count));
+
+	task_scheduler.stop ();
+}
+
+TEST_F (TasksTest, NestedJobsArePushedToLocalDequeAndStolen) {
+	TaskScheduler task_scheduler (4);
+	task_scheduler.start ();
+
+	constexpr int child_count = 512;
+	std::atomic<int> completed{0};
+
+	task_scheduler.submit ([&] {
+		EXPECT_TRUE (task_scheduler.on_worker_thread ());
+		for (int i = 0; i < child_count; ++i) {
+			task_scheduler.submit ([&] {
+				std::this_thread::sleep_for (std::chrono::microseconds (50));
+				++completed;
+			});
+		}
+	});
+
+	task_scheduler.wait_idle ();
+	EXPECT_EQ (completed, child_count);
+	EXPECT_FALSE (task_scheduler.on_worker_thread ());
+
+	const TaskSchedulerStats stats = task_scheduler.get_stats ();
+	EXPECT_EQ (stats.local_pushes, static_cast<uint64_t> (child_count));
+	EXPECT_GT (stats.steals, 0u);
+	EXPECT_EQ (stats.submitted, stats.executed);
+
+	task_scheduler.stop ();
+}
+
+TEST_F (TasksTest, HelpingWaitRunsQueuedJobsOnCaller) {
+	TaskScheduler task_scheduler (1);
+	task_scheduler.start ();
+
+	std::promise<void> release;
+	std::shared_future<void> released = release.get_future ().share ();
+	std::atomic<bool> blocked{false};
+	task_scheduler.submit ([&blocked, released] {
+		blocked = true;
+		released.wait ();
+	});
+	while (!blocked)
+		std::this_thread::yield ();
+
+	constexpr int job_count = 64;
+	const std::thread::id caller = std::this_thread::get_id ();
+	std::atomic<int> on_caller{0};
+
+	TaskGroup group;
+	for (int i = 0; i < job_count; ++i)
+		task_scheduler.submit (
+			[&] {
+				if (std::this_thread::get_id () == caller)
+					++on_caller;
+			},
+			group
+		);
+
+	task_scheduler.wait (group, WaitMode::Help);
+	EXPECT_EQ (on_caller, job_count);
+	EXPECT_EQ (task_scheduler.get_stats ().helped, uint64_t{job_count});
+
+	release.set_value ();
+	task_scheduler.wait_idle (WaitMode::Help);
+	EXPECT_EQ (task_scheduler.busy_tasks, 0);
+	task_scheduler.stop ();
+}
+
+TEST_F (TasksTest, CountsJobsSubmittedBeforeStart) {
+	TaskScheduler task_scheduler (2);
+
+	constexpr int job_count = 100;
+	std::atomic<int> completed{0};
+	for (int i = 0; i < job_count; ++i)
+		task_scheduler.submit ([&] { ++completed; });
+	EXPECT_EQ (task_scheduler.busy_tasks, job_count);
+
+	task_scheduler.wait_idle (WaitMode::Help);
+	EXPECT_EQ (completed, job_count);
+	EXPECT_EQ (task_scheduler.busy_tasks, 0);
+
+	for (int i = 0; i < job_count; ++i)
+		task_scheduler.submit ([&] { ++completed; });
+	task_scheduler.start ();
+	task_scheduler.wait_idle ();
+	EXPECT_EQ (completed, 2 * job_count);
+	EXPECT_EQ (task_scheduler.busy_tasks, 0);
+	task_scheduler.stop ();
+}
+
+TEST_F (TasksTest, BlockingWaitRunsJobsWhenNotStarted) {
+	TaskSchedulerConfig config;
+	config.latency_threads = 1;
+	config.background_threads = 1;
+	TaskScheduler task_scheduler (config);
+
+	std::atomic<int> completed{0};
+	task_scheduler.submit ([&] { ++completed; });
+	task_scheduler.submit_background ([&] { ++completed; });
+	const JobHandle handle = task_scheduler.schedule ([&] { ++completed; });
+
+	task_scheduler.wait (handle);
+	task_scheduler.wait_idle ();
+	EXPECT_EQ (completed, 3);
+	EXPECT_EQ (task_scheduler.busy_tasks, 0);
+}
+
+TEST_F (TasksTest, EndFrameDrainsWorkerTelemetry) {
+	TaskScheduler task_scheduler (2);
+	task_scheduler.start ();
+	task_scheduler.end_frame ();
+
+	constexpr int job_count = 100;
+	for (int i = 0; i < job_count; ++i)
+		task_scheduler.submit ([] {
+			std::this_thread::sleep_for (std::chrono::microseconds (20));
+		});
+	task_scheduler.wait_idle ();
+	task_scheduler.end_frame ();
+
+	const TaskSchedulerTelemetry& telemetry = task_scheduler.get_telemetry ();
+	ASSERT_EQ (telemetry.workers.size (), 2u);
+	EXPECT_GT (telemetry.frame_ms, 0.0f);
+
+	uint64_t jobs = telemetry.caller.jobs;
+	for (const WorkerUtilization& worker : telemetry.workers) {
+		jobs += worker.jobs;
+		EXPECT_LE (worker.utilization, 1.0f);
+	}
+	EXPECT_EQ (jobs, uint64_t{job_count});
+	EXPECT_EQ (telemetry.queue_wait.count, uint64_t{job_count});
+	EXPECT_EQ (telemetry.run_time.count, uint64_t{job_count});
+	EXPECT_GE (telemetry.run_time.percentile_us (0.5f), 20.0f);
+
+	task_scheduler.end_frame ();
+	EXPECT_EQ (telemetry.run_time.count, 0u);
+	task_scheduler.stop ();
+}
+
+TEST (LatencyHistogramTest, BucketsDoubleFrom256Nanoseconds) {
+	EXPECT_EQ (LatencyHistogram::bucket_for (0), 0u);
+	EXPECT_EQ (LatencyHistogram::bucket_for (255), 0u);
+	EXPECT_EQ (LatencyHistogram::bucket_for (256), 1u);
+	EXPECT_EQ (LatencyHistogram::bucket_for (1000), 2u);
+	EXPECT_EQ (
+		LatencyHistogram::bucket_for (UINT64_MAX),
+		LatencyHistogram::bucket_count - 1
+	);
+
+	LatencyHistogram histogram;
+	histogram.buckets[0] = 90;
+	histogram.buckets[4] = 10;
+	histogram.count = 100;
+	EXPECT_FLOAT_EQ (histogram.percentile_us (0.5f), 0.256f);
+	EXPECT_FLOAT_EQ (histogram.percentile_us (0.95f), 4.096f);
+}
+
+TEST (ScratchArenaTest, RewindsToMarkerAndCountsFallbacks) {
+	ScratchArena arena (256);
+
+	const ScratchMarker start = arena.mark ();
+	void* first = arena.allocate (64, 16);
+	{
+		std::pmr::vector<int> spill (&arena);
+		spill.resize (128);
+		EXPECT_EQ (arena.get_stats ().fallbacks, 1u);
+	}
+	EXPECT_EQ (arena.used (), 64u);
+	EXPECT_GE (arena.get_stats ().high_water, 64u + 128 * sizeof (int));
+
+	arena.rewind (start);
+	EXPECT_EQ (arena.used (), 0u);
+	EXPECT_EQ (arena.allocate (64, 16), first);
+}
+
+TEST_F (TasksTest, JobsGetTheirWorkersScratchArena) {
+	TaskSchedulerConfig config;
+	config.latency_threads = 2;
+	config.scratch_bytes = 1024;
+	TaskScheduler task_scheduler (config);
+	task_scheduler.start ();
+
+	std::atomic<int> wrong_arena{0};
+	for (int i = 0; i < 64; ++i)
+		task_scheduler.submit ([&, i] {
+			ScratchScope scope;
+			std::pmr::vector<int> temp (scope.resource ());
+			temp.resize (i < 32 ? 16 : 1024);
+			if (scope.resource () != &scratch_arena ())
+				++wrong_arena;
+		});
+	task_scheduler.wait_idle ();
+
+	const TaskSchedulerStats stats = task_scheduler.get_stats ();
+	EXPECT_EQ (wrong_arena, 0);
+	EXPECT_EQ (stats.scratch_fallbacks, 32u);
+	EXPECT_GE (stats.scratch_high_water, 1024 * sizeof (int));
+
+	task_scheduler.stop ();
+}
+
+TEST (WorkStealingDequeTest, OwnerPopsLifoAndThiefStealsFifo) {
+	WorkStealingDeque<int> deque (4);
+	for (int i = 0; i < 10; ++i)
+		deque.push (i);
+
+	int value = -1;
+	ASSERT_TRUE (deque.pop (value));
+	EXPECT_EQ (value, 9);
+
+	ASSERT_EQ (deque.steal (value), StealResult::Success);
+	EXPECT_EQ (value, 0);
+
+	EXPECT_EQ (deque.size_approx (), 8);
+}
+
+TEST (WorkStealingDequeTest, EmptyDequeReportsNothing) {
+	WorkStealingDeque<int> deque;
+	int value = 0;
+
+	EXPECT_FALSE (deque.pop (value));
+	EXPECT_EQ (deque.steal (value), StealResult::Empty);
+	EXPECT_TRUE (deque.empty ());
+}
+
+TEST (WorkStealingDequeTest, ConcurrentThievesTakeEachItemOnce) {
+	constexpr int item_count = 100000;
+	WorkStealingDeque<int> deque (64);
+
+	std::vector<std::atomic<int>> seen (item_count);
+	std::atomic<bool> done{false};
+
+	auto thief = [&] {
+		int value = 0;
+		while (!done || !deque.empty ()) {
+			if (deque.steal (value) == StealResult::Success)
+				++seen[value];
+		}
+	};
+
+	std::thread thief_a (thief);
+	std::thread thief_b (thief);
+
+	int value = 0;
+	for (int i = 0; i < item_count; ++i) {
+		deque.push (i);
+		if (i % 3 == 0 && deque.pop (value))
+			++seen[value];
+	}
+	while (deque.pop (value))
+		++seen[value];
+
+	done = true;
+	thief_a.join ();
+	thief_b.join ();
+
+	for (int i = 0; i < item_count; ++i)
+		ASSERT_EQ (seen[i].load (), 1) << "item " << i;
+}
+
+TEST_F (TasksTest, ParallelForVisitsEveryIndexExactlyOnce) {
+	TaskScheduler task_scheduler (4);
+	task_scheduler.start ();
+
+	constexpr size_t count = 16384;
+	std::vector<std::atomic<int>> visits (count);
+
+	task_scheduler.parallel_for (0, count, 256, [&] (size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i)
+			++visits[i];
+	});
+
+	for (size_t i = 0; i < count; ++i)
+		ASSERT_EQ (visits[i].load (), 1) << "index " << i;
+
+	task_scheduler.stop ();
+}
+
+TEST_F (TasksTest, ParallelForRunsInlineWhenSchedulerIsStopped) {
+	TaskScheduler task_scheduler (4);
+
+	const std::thread::id caller = std::this_thread::get_id ();
+	std::atomic<int> off_thread_chunks{0};
+	size_t visited = 0;
+
+	task_scheduler.parallel_for (10, 1000, 16, [&] (size_t begin, size_t end) {
+		if (std::this_thread::get_id () != caller)
+			++off_thread_chunks;
+		visited += end - begin;
+	});
+
+	EXPECT_EQ (visited, 990u);
+	EXPECT_EQ (off_thread_chunks, 0);
+}
+
+TEST_F (TasksTest, ParallelForCanBeNestedInsideJobs) {
+	TaskScheduler task_scheduler (2);
+	task_scheduler.start ();
+
+	std::atomic<size_t> visited{0};
+	for (int job = 0; job < 8; ++job) {
+		task_scheduler.submit ([&] {
+			task_scheduler.parallel_for (0, 4096, 64, [&] (size_t b, size_t e) {
+				visited += e - b;
+			});
+		});
+	}
+
+	task_scheduler.wait_idle ();
+	EXPECT_EQ (visited, 8u * 4096u);
+
+	task_scheduler.stop ();
+}
+
+TEST_F (TasksTest, ParallelReduceCombinesChunksInOrder) {
+	TaskScheduler task_scheduler (4);
+	task_scheduler.start ();
+
+	const uint64_t sum = task_scheduler.parallel_reduce (
+		1, 100001, 128, uint64_t{0},
+		[] (size_t begin, size_t end) {
+			uint64_t partial = 0;
+			for (size_t i = begin; i < end; ++i)
+				partial += i;
+			return partial;
+		},
+		[] (uint64_t a, uint64_t b) { return a + b; }
+	);
+	EXPECT_EQ (sum, 5000050000ull);
+
+	const std::string joined = task_scheduler.parallel_reduce (
+		0, 10, 1, std::string{},
+		[] (size_t begin, size_t) { return std::to_string (begin); },
+		[] (std::string a, const std::string& b) { return a + b; }
+	);
+	EXPECT_EQ (joined, "0123456789");
+
+	task_scheduler.stop ();
+}
+
+TEST_F (TasksTest, ParallelReduceHandlesBoolAndWideRanges) {
+	TaskScheduler task_scheduler (4);
+	task_scheduler.start ();
+
+	const bool all_even = task_scheduler.parallel_reduce (
+		0, 1 << 16, 1, true,
+		[] (size_t begin, size_t end) {
+			bool even = true;
+			for (size_t i = begin; i < end; ++i)
+				even = even && ((i * 2) % 2 == 0);
+			return even;
+		},
+		[] (bool a, bool b) { return a && b; }
+	);
+	EXPECT_TRUE (all_even);
+
+	task_scheduler.stop ();
+}
+
+TEST_F (TasksTest, BackgroundJobsStayOnBackgroundWorkers) {
+	TaskSchedulerConfig config;
+	config.latency_threads = 2;
+	config.background_threads = 1;
+	TaskScheduler task_scheduler (config);
+	task_scheduler.start ();
+
+	std::atomic<int> misplaced{0};
+	for (int i = 0; i < 50; ++i) {
+		task_scheduler.submit_background ([&] {
+			if (!task_scheduler.on_background_worker ())
+				++misplaced;
+
+			// Nested jobs inherit the lane of the job that spawned them.
+			task_scheduler.submit ([&] {
+				if (!task_scheduler.on_background_worker ())
+					++misplaced;
+			});
+		});
+		task_scheduler.submit ([&] {
+			if (task_scheduler.on_background_worker ())
+				++misplaced;
+		});
+	}
+
+	task_scheduler.wait_idle ();
+	EXPECT_EQ (misplaced, 0);
+	EXPECT_EQ (task_scheduler.thread_count, 3u);
+	EXPECT_EQ (task_scheduler.get_stats ().background_executed, 100u);
+
+	task_scheduler.stop ();
+}
+
+TEST_F (TasksTest, BackgroundJobsFallBackToLatencyWorkers) {
+	TaskScheduler task_scheduler (2);
+	task_scheduler.start ();
+
+	std::atomic<int> completed{0};
+	for (int i = 0; i < 10; ++i)
+		task_scheduler.submit_background ([&] { ++completed; });
+
+	task_scheduler.wait_idle ();
+	EXPECT_EQ (completed, 10);
+	EXPECT_EQ (task_scheduler.get_stats ().background_executed, 0u);
+
+	task_scheduler.stop ();
+}
+
+#if defined(__linux__)
+TEST_F (TasksTest, NamesAndPinsWorkerThreads) {
+	TaskSchedulerConfig config;
+	config.latency_threads = 1;
+	config.name = "sim";
+	config.latency.policy = ThreadPolicy::Inherit;
+	config.affinity = {{0}};
+	TaskScheduler task_scheduler (config);
+	task_scheduler.start ();
+
+	char name[16] = {};
+	int cpu = -1;
+	task_scheduler.submit ([&] {
+		pthread_getname_np (pthread_self (), name, sizeof (name));
+		cpu = sched_getcpu ();
+	});
+
+	task_scheduler.wait_idle ();
+	EXPECT_STREQ (name, "sim-0");
+	EXPECT_EQ (cpu, 0);
+	EXPECT_EQ (task_scheduler.get_stats ().thread_config_failures, 0u);
+
+	task_scheduler.stop ();
+}
+#endif
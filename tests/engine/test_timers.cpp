@@ -0,0 +1,107 @@
+#include "engine/runtime/tasks/tasks.h"
+#include "engine/runtime/timers/timers.h"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+class TimersTest : public ::testing::Test {
+  protected:
+	void SetUp () override { task_scheduler.start (); }
+	void TearDown () override { task_scheduler.stop (); }
+
+	void advance (const float delta_time_ms) {
+		timers.update (delta_time_ms, task_scheduler);
+		timers.join (task_scheduler);
+	}
+
+	TaskScheduler task_scheduler{2};
+	TimerWheel timers;
+};
+
+TEST_F (TimersTest, FiresEveryTimerOnceWhenDue) {
+	std::mt19937 random (7);
+	std::uniform_int_distribution<uint32_t> delays (1, 400000);
+
+	constexpr int timer_count = 5000;
+	std::vector<uint32_t> due (timer_count);
+	std::atomic<int> fired{0};
+	std::atomic<int> early{0};
+
+	for (int i = 0; i < timer_count; ++i) {
+		due[i] = delays (random);
+		timers.add (static_cast<float> (due[i]), [&, tick = due[i]] () {
+			if (timers.get_tick () < tick)
+				++early;
+			++fired;
+		});
+	}
+	std::sort (due.begin (), due.end ());
+
+	while (timers.size () > 0) {
+		advance (97.0f);
+		const auto expected = std::upper_bound (
+								  due.begin (), due.end (), timers.get_tick ()
+							  )
+							  - due.begin ();
+		ASSERT_EQ (fired, expected);
+	}
+
+	EXPECT_EQ (early, 0);
+	const TimerStats stats = timers.get_stats ();
+	EXPECT_EQ (stats.expired, static_cast<uint64_t> (timer_count));
+	EXPECT_GT (stats.cascaded, 0u);
+	EXPECT_LT (stats.batches, stats.expired);
+}
+
+TEST_F (TimersTest, CancelledTimersNeverFire) {
+	std::atomic<int> fired{0};
+	std::vector<TimerHandle> handles;
+	for (int i = 0; i < 100; ++i)
+		handles.push_back (timers.add (50.0f + i, [&fired] { ++fired; }));
+
+	for (size_t i = 0; i < handles.size (); i += 2)
+		EXPECT_TRUE (timers.cancel (handles[i]));
+	EXPECT_FALSE (timers.cancel (handles[0]));
+	EXPECT_EQ (timers.size (), 50u);
+
+	advance (200.0f);
+	EXPECT_EQ (fired, 50);
+	EXPECT_FALSE (timers.pending (handles[1]));
+	EXPECT_FALSE (timers.cancel (handles[1]));
+
+	// Recycled nodes do not answer to stale handles.
+	const TimerHandle reused = timers.add (10.0f, [] {});
+	EXPECT_FALSE (timers.pending (handles[0]));
+	EXPECT_TRUE (timers.pending (reused));
+}
+
+TEST_F (TimersTest, CallbacksCanRearmTimers) {
+	std::atomic<int> fired{0};
+	std::function<void ()> cooldown = [&] {
+		if (++fired < 3)
+			timers.add (20.0f, [&] { cooldown (); });
+	};
+	timers.add (20.0f, [&] { cooldown (); });
+
+	for (int i = 0; i < 6; ++i)
+		advance (16.0f);
+	EXPECT_EQ (fired, 3);
+	EXPECT_EQ (timers.size (), 0u);
+}
+
+TEST_F (TimersTest, DeadlinesPastTheOuterLevelAreRefiled) {
+	constexpr uint64_t far = (uint64_t{1} << 24) + 5000;
+	std::atomic<bool> fired{false};
+	timers.add (static_cast<float> (far), [&fired] { fired = true; });
+
+	while (timers.get_tick () + (1u << 20) < far) {
+		advance (static_cast<float> (1u << 20));
+		ASSERT_FALSE (fired);
+	}
+	advance (static_cast<float> (1u << 20));
+	EXPECT_TRUE (fired);
+}